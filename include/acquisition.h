@@ -0,0 +1,134 @@
+#ifndef ACQUISITION_H
+#define ACQUISITION_H
+
+#include <Arduino.h>
+#include <atomic>
+
+#include "opt3001_array.h"
+#include "lux_frame.h"
+#include "frame_buffer.h"
+#include "activity_map.h"
+
+// ----------------------------------------------------
+// Erfassungs-Tasks
+// ----------------------------------------------------
+// Core 1 (APP_CPU), getrennt von WiFi/lwIP/ETH auf Core 0.
+// loopTask (WebServer) läuft dort mit Priorität 1: ein langer
+// HTTP-Handler wird von den Erfassungs-Tasks verdrängt, nicht
+// umgekehrt. Die Worker blockieren jeden Tick, loopTask
+// bekommt die Zeit dazwischen.
+#define ACQ_TASK_CORE   APP_CPU_NUM
+#define ACQ_TASK_PRIO   2        // über loopTask (1)
+#define ACQ_TASK_STACK  4096
+#define FRAME_PERIOD_MS 100
+#define SCHED_TICK_MS   2        // Abfrageraster des CRF-Schedulers
+#define MUX_VERIFY_FRAMES 50     // Mux-Control-Register alle 50 Frames prüfen
+#define RESCAN_TIMEOUT_MS 5000   // Discovery + Settle-Kalibrierung je Bus
+
+// ----------------------------------------------------
+// Je I2C-Bus bedient ein eigener Worker-Task sein Sensor-
+// Array (CRF-Scheduler im SCHED_TICK_MS-Raster), die Busse
+// laufen also parallel. Ein Koordinator-Task gibt das
+// Frame-Raster vor: jeder Worker trägt seine Zeilen in
+// eigene Staging-Zeilen ein und quittiert; erst danach
+// kopiert der Koordinator sie in den hinteren Puffer und
+// veröffentlicht den Frame über den Seqlock-Doppelpuffer.
+// Befehle tragen eine laufende Nummer, quittiert wird mit
+// dieser Nummer: ein Worker, der den Timeout verpasst,
+// schreibt nie in einen fremden oder veröffentlichten
+// Frame, seine Pixel stehen im Frame auf CODE_TIMEOUT.
+// Aus jedem Frame führt der Koordinator die Aktivität je
+// Zeile nach; im Fovea-Modus lesen die Worker ruhige Zeilen
+// seltener (Opt3001Array::setRowSchedule).
+// Im Snapshot-Modus triggert der Koordinator alle Busse
+// gleichzeitig und veröffentlicht, sobald alle fertig sind.
+// Nach begin() gehören die I2C-Busse ausschließlich den
+// Workern.
+// ----------------------------------------------------
+class Acquisition {
+public:
+  bool begin(Opt3001Array *const arrays[], uint8_t count);
+
+  // Letzten vollständigen Frame kopieren (blockiert nie den Scan)
+  bool latest(LuxFrame &out) const { return m_frames.read(out); }
+
+  // Snapshot-Modus anfordern (wird vom Koordinator übernommen)
+  void setSnapshot(bool on) { m_wantSnapshot.store(on, std::memory_order_relaxed); }
+  bool snapshot() const { return m_wantSnapshot.load(std::memory_order_relaxed); }
+
+  // Fenster-Modus (nur Änderungen lesen), von den Workern übernommen
+  void setWindow(bool on) { m_window.store(on, std::memory_order_relaxed); }
+  bool window() const { return m_window.load(std::memory_order_relaxed); }
+
+  // Fovea: aktive Zeilen (+ Nachbarn) mit voller Rate, Rest seltener,
+  // kein Wert älter als maxStaleMs
+  void setFovea(bool on) { m_fovea.store(on, std::memory_order_relaxed); }
+  bool fovea() const { return m_fovea.load(std::memory_order_relaxed); }
+  // Auf den Bereich begrenzt, den alle Arrays umsetzen
+  // (Opt3001Array::minStaleMs/maxStaleLimitMs). Rückgabe: wirksamer Wert
+  uint16_t setMaxStaleMs(uint16_t ms);
+  uint16_t maxStaleMs() const { return m_maxStaleMs.load(std::memory_order_relaxed); }
+  uint32_t hotRows() const { return m_hotRows.load(std::memory_order_relaxed); }
+
+  // Topologie aller Busse neu vermessen. Der Koordinator hält
+  // dafür die Erfassung an (CMD_RESCAN), die Worker vermessen
+  // parallel; so lange wird kein Frame veröffentlicht
+  void requestRescan() { m_rescans.fetch_add(1, std::memory_order_relaxed); }
+
+  uint32_t frames()  const { return m_frames.published(); }
+  uint32_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+  uint32_t scanUs()  const { return m_scanUs.load(std::memory_order_relaxed); }
+
+private:
+  struct Worker {
+    Acquisition  *acq;
+    Opt3001Array *array;
+    TaskHandle_t  task;
+    uint32_t      busyUs;      // Busy-Zeit seit dem letzten Frame (nur Worker)
+    uint32_t      triggerUs;   // Snapshot: Zeitpunkt des letzten Triggers
+
+    // Vom Worker bei CMD_CAPTURE geschrieben; der Koordinator
+    // liest sie nur, wenn 'captured' die aktuelle Befehlsnummer trägt
+    LuxFrame      stage;       // eigene Pixel (code, raw, ageMs, valid)
+    uint64_t      owned;       // Bitmaske der eigenen Pixel
+    uint32_t      scanUs;      // Busy-Zeit im Frame
+
+    std::atomic<uint32_t> captured{0};    // Quittung CMD_CAPTURE (Befehlsnummer)
+    std::atomic<uint32_t> triggered{0};   // Quittung CMD_TRIGGER
+    std::atomic<uint32_t> rescanned{0};   // Quittung CMD_RESCAN
+
+    uint64_t      lastOwned;   // nur Koordinator: Pixel der letzten Quittung
+  };
+
+  static void coordinatorEntry(void *arg);
+  static void workerEntry(void *arg);
+  void runCoordinator();
+  void runWorker(Worker &w);
+
+  // Befehl mit neuer Nummer an alle Worker, dann warten, bis
+  // jeder sie in 'ack' quittiert hat. false = Timeout
+  bool command(uint32_t cmd, std::atomic<uint32_t> Worker::*ack, TickType_t timeout);
+  void publishFrame(LuxFrame &f, uint32_t triggerUs);
+
+  Worker                          m_workers[NUM_I2C_BUSES];
+  uint8_t                         m_numWorkers = 0;
+  TaskHandle_t                    m_coordinator = NULL;
+  std::atomic<uint32_t>           m_command{0};   // Nummer des letzten Befehls
+
+  SeqlockFrameBuffer<LuxFrame>    m_frames;
+  uint32_t                        m_seq = 0;
+  uint32_t                        m_lastScanEndUs = 0;   // nur Koordinator
+  std::atomic<bool>               m_snapshotMode{false};   // vom Koordinator an die Worker
+  std::atomic<uint32_t>           m_dropped{0};   // ausgefallene Frame-Slots (Scan zu langsam)
+  std::atomic<uint32_t>           m_scanUs{0};    // Busy-Zeit des langsamsten Busses im letzten Frame
+  std::atomic<bool>               m_wantSnapshot{false};
+  std::atomic<bool>               m_window{false};
+
+  ActivityMap                     m_activity;     // nur Koordinator
+  std::atomic<uint32_t>           m_hotRows{0};
+  std::atomic<bool>               m_fovea{false};
+  std::atomic<uint32_t>           m_rescans{0};   // angeforderte Rescans, Koordinator zählt mit
+  std::atomic<uint16_t>           m_maxStaleMs{FOVEA_MAX_STALE_MS};
+};
+
+#endif
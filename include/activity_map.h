@@ -0,0 +1,44 @@
+#ifndef ACTIVITY_MAP_H
+#define ACTIVITY_MAP_H
+
+#include <stdint.h>
+
+#include "topology.h"
+#include "lux_frame.h"
+
+static_assert(TOTAL_ROWS <= 32, "Zeilen-Maske fasst max. 32 Zeilen");
+
+// ----------------------------------------------------
+// Aktivität je Zeile aus aufeinanderfolgenden Frames
+//
+// Je Pixel die relative Änderung gegenüber dem vorigen
+// Frame in Promille (Untergrenze ACTIVITY_FLOOR_CENTILUX
+// als Bezug, damit Rauschen im Dunkeln nicht zählt); je
+// Zeile wird das Quadrat des größten Werts als gleitender
+// Mittelwert geführt (Varianz der Änderung, EWMA 1/8).
+// Zeilen über der Schwelle sind "heiß", ihre Nachbarzeilen
+// werden mit hinzugenommen (Fovea).
+// ----------------------------------------------------
+#define ACTIVITY_EWMA_SHIFT     3     // Gewicht 1/8
+#define ACTIVITY_HOT_PERMILLE   20    // ab 2 % typischer Änderung je Frame
+#define ACTIVITY_FLOOR_CENTILUX 100   // 1 lx
+
+class ActivityMap {
+public:
+  // Neuen Frame einrechnen (vom Koordinator nach jedem Frame)
+  void update(const LuxFrame &f);
+
+  // Bit r: Zeile r oder eine Nachbarzeile ist aktiv
+  uint32_t hotRows() const { return m_hotRows; }
+
+  // Varianz der relativen Änderung (Promille²) einer Zeile
+  uint32_t activity(uint8_t row) const { return m_activity[row]; }
+
+private:
+  uint32_t m_prev[TOTAL_ROWS][NUM_SENSORS_PER_CHANNEL];   // Centilux des vorigen Frames
+  uint64_t m_prevValid = 0;
+  uint32_t m_activity[TOTAL_ROWS] = { 0 };
+  uint32_t m_hotRows = 0;
+};
+
+#endif
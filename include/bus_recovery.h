@@ -0,0 +1,56 @@
+#ifndef BUS_RECOVERY_H
+#define BUS_RECOVERY_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <atomic>
+
+// ----------------------------------------------------
+// Erkennung und Behebung eines hängenden I2C-Busses
+//
+// Bricht ein Slave mitten in einem Lesezugriff ab (Reset,
+// Störung), kann er SDA dauerhaft low halten: jeder weitere
+// Zugriff scheitert bis zum Power-Cycle. Erkannt wird das
+// an Wire-Fehlercodes (Bus-Fehler / Timeout statt NACK) und
+// durch Abtasten der Leitungen im Ruhezustand.
+//
+// recover() gibt die Pins von Wire frei, taktet SCL bis zu
+// neunmal, bis der Slave SDA loslässt (er schiebt sein
+// angefangenes Byte zu Ende), erzeugt ein STOP und startet
+// Wire neu. Mux-Zustände und Register-Pointer stellt der
+// Aufrufer wieder her (Opt3001Array::recoverBus).
+// ----------------------------------------------------
+#define BUS_RECOVERY_CLOCKS   9
+#define BUS_RECOVERY_HALF_US  5     // halbe Taktperiode (100 kHz)
+#define BUS_IDLE_SAMPLES      4     // Leitung gilt als low, wenn alle Proben low
+
+class BusRecovery {
+public:
+  void begin(TwoWire &wire, int sda, int scl, uint32_t freq);
+
+  // Wire-Ergebnis (endTransmission) deutet auf Bus- statt Slave-Fehler:
+  // 4 = sonstiger Fehler (Bus belegt, Arbitrierung), 5 = Timeout
+  static bool isBusError(uint8_t endTransmissionResult) {
+    return endTransmissionResult == 4 || endTransmissionResult == 5;
+  }
+
+  // Ruhezustand: SDA und SCL high (nur zwischen Transaktionen aufrufen)
+  bool linesIdle() const;
+
+  // Recovery-Sequenz. Rückgabe: 0 = Bus wieder frei, -EBUSY = hängt weiter
+  int recover();
+
+  uint32_t recoveries() const { return m_recoveries.load(std::memory_order_relaxed); }
+  uint32_t failures()   const { return m_failures.load(std::memory_order_relaxed); }
+
+private:
+  TwoWire *m_wire = NULL;
+  int      m_sda  = -1;
+  int      m_scl  = -1;
+  uint32_t m_freq = 100000;
+
+  std::atomic<uint32_t> m_recoveries{0};   // durchgeführte Sequenzen
+  std::atomic<uint32_t> m_failures{0};     // davon ohne Erfolg
+};
+
+#endif
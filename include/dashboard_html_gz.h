@@ -0,0 +1,198 @@
+// Automatisch erzeugt von tools/embed_dashboard.py aus web/index.html
+// - nicht von Hand ändern
+#ifndef DASHBOARD_HTML_GZ_H
+#define DASHBOARD_HTML_GZ_H
+
+#include <Arduino.h>
+
+#define DASHBOARD_HTML_GZ_ETAG "\"be6b4a11a83255ce\""
+#define DASHBOARD_HTML_SIZE    6308   // unkomprimiert
+
+static const uint8_t DASHBOARD_HTML_GZ[2932] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xa5, 0x59, 0xeb, 0x6e, 0xdb, 0xca,
+  0x11, 0xfe, 0xaf, 0xa7, 0xd8, 0x20, 0xc1, 0x21, 0x69, 0x93, 0x14, 0x25, 0xcb, 0x3e, 0x29, 0x25,
+  0xaa, 0x70, 0x7c, 0x09, 0x8c, 0xe3, 0xc4, 0xa9, 0x9d, 0xa4, 0xe8, 0x09, 0x02, 0x7b, 0x45, 0x2e,
+  0xc5, 0x8d, 0x29, 0x52, 0x67, 0xb9, 0xd4, 0xc5, 0xb2, 0x80, 0xfe, 0xea, 0x03, 0xb4, 0xef, 0xd2,
+  0x5f, 0xf9, 0x97, 0x37, 0x39, 0x4f, 0xd2, 0x99, 0x5d, 0x4a, 0xa2, 0x62, 0x3b, 0x3d, 0x68, 0x61,
+  0x40, 0xbc, 0xec, 0xcc, 0xec, 0x5c, 0xbf, 0x99, 0xa5, 0x7b, 0xcf, 0x8e, 0x2f, 0x8e, 0xde, 0xff,
+  0xed, 0xdd, 0x09, 0x49, 0xe4, 0x28, 0xed, 0x37, 0x7a, 0xcf, 0x1c, 0xa7, 0x41, 0xc8, 0x5f, 0xd9,
+  0xe0, 0xc3, 0x19, 0xf9, 0xfd, 0xef, 0xff, 0x22, 0xaf, 0x05, 0x8d, 0xf9, 0x2d, 0xd9, 0x85, 0x57,
+  0x42, 0x32, 0x92, 0xb1, 0x01, 0xcb, 0x18, 0xcf, 0x68, 0x16, 0x31, 0x61, 0x93, 0x33, 0xb8, 0xcc,
+  0x9c, 0x5f, 0x69, 0x92, 0xb2, 0x8c, 0x7c, 0xfb, 0x3a, 0x60, 0x82, 0x7c, 0x61, 0x11, 0x1b, 0x91,
+  0x5f, 0x04, 0xe3, 0x85, 0x0b, 0x92, 0xfe, 0x52, 0xb2, 0x34, 0x65, 0x24, 0xfe, 0xf6, 0x55, 0x10,
+  0x9e, 0x85, 0x69, 0x19, 0xb1, 0x66, 0x44, 0x8b, 0x64, 0x90, 0x53, 0x11, 0x5d, 0xe3, 0xa6, 0xd7,
+  0xc3, 0x3b, 0x37, 0x21, 0xa6, 0xcc, 0xf3, 0xb4, 0x68, 0xb2, 0xd1, 0x80, 0x45, 0xd7, 0x6b, 0x02,
+  0x77, 0x3c, 0xb7, 0xba, 0x20, 0xe5, 0x92, 0x16, 0x12, 0x64, 0x97, 0x59, 0x44, 0xde, 0xd3, 0x81,
+  0x92, 0xc8, 0x32, 0x09, 0xef, 0x12, 0xd8, 0x97, 0x8f, 0xc8, 0x2b, 0x91, 0x4f, 0x0b, 0x20, 0xa0,
+  0x65, 0x41, 0x9a, 0x32, 0x1f, 0xe7, 0x69, 0x3e, 0x9c, 0xbb, 0x0d, 0xc7, 0x01, 0x8b, 0x94, 0x61,
+  0xbd, 0x84, 0xd1, 0xa8, 0xdf, 0x1b, 0x31, 0x49, 0x49, 0x98, 0x50, 0x51, 0x30, 0x19, 0x18, 0xa5,
+  0x8c, 0x9d, 0x97, 0x06, 0x90, 0xa8, 0xd7, 0x19, 0x1d, 0xb1, 0xc0, 0x98, 0x70, 0x36, 0x1d, 0xe7,
+  0x42, 0x1a, 0x24, 0xcc, 0x33, 0x09, 0x9b, 0x04, 0xc6, 0x94, 0x47, 0x32, 0x09, 0x22, 0x36, 0xe1,
+  0x21, 0x73, 0xd4, 0x83, 0xcd, 0x33, 0x2e, 0x39, 0x4d, 0x9d, 0x22, 0xa4, 0x29, 0x0b, 0x5a, 0x28,
+  0xa3, 0x90, 0xf3, 0x94, 0xf5, 0x1b, 0x83, 0x3c, 0x9a, 0x2f, 0x06, 0x34, 0xbc, 0x1d, 0x8a, 0x1c,
+  0xd4, 0xf5, 0x9f, 0xb7, 0x5a, 0xad, 0x6e, 0x08, 0xfa, 0x08, 0xff, 0x39, 0x63, 0xac, 0x1b, 0x83,
+  0x54, 0x27, 0xa6, 0x23, 0x9e, 0xce, 0xfd, 0x43, 0x01, 0x32, 0xec, 0x82, 0x66, 0x85, 0x03, 0xca,
+  0xf3, 0xb8, 0x3b, 0xa2, 0x62, 0xc8, 0x33, 0xdf, 0xeb, 0x8e, 0x69, 0x14, 0xf1, 0x6c, 0x08, 0x77,
+  0x92, 0xcd, 0xa4, 0x43, 0x53, 0x3e, 0xcc, 0xfc, 0x10, 0xb4, 0x61, 0x62, 0xd9, 0x48, 0xda, 0x0b,
+  0x4d, 0xe8, 0x80, 0xa5, 0x7e, 0xab, 0x3d, 0x9e, 0x55, 0x8c, 0xce, 0x20, 0x97, 0x32, 0x1f, 0xf9,
+  0x9d, 0xf1, 0x6c, 0xd9, 0x18, 0x57, 0x44, 0xf8, 0xa4, 0x77, 0x2d, 0xf8, 0x1d, 0xf3, 0x5b, 0x7b,
+  0xb8, 0xe8, 0x4e, 0x05, 0x1d, 0x2f, 0x22, 0x5e, 0x8c, 0x53, 0x3a, 0xf7, 0xe3, 0x94, 0xcd, 0xba,
+  0x5f, 0xca, 0x42, 0xf2, 0x78, 0xee, 0x54, 0x66, 0x57, 0xbb, 0x75, 0xd5, 0xd6, 0x0e, 0x97, 0x6c,
+  0x54, 0x28, 0x3a, 0xa7, 0x90, 0x54, 0xc8, 0xee, 0x90, 0x8e, 0xfd, 0x76, 0x67, 0xbd, 0xb3, 0xdf,
+  0xf2, 0x70, 0x17, 0x5c, 0x47, 0xc9, 0x3e, 0xfe, 0x2c, 0x1b, 0xc5, 0x64, 0xb8, 0xe5, 0x8a, 0x76,
+  0xbb, 0xdd, 0x1d, 0xe4, 0x02, 0x32, 0xc7, 0x11, 0x34, 0xe2, 0x65, 0xe1, 0xbf, 0x44, 0x65, 0x42,
+  0x2e, 0xc2, 0x94, 0x2d, 0x0a, 0x29, 0xf2, 0x5b, 0xe6, 0x3f, 0xef, 0x74, 0x3a, 0x5d, 0x7d, 0xaf,
+  0x9d, 0xed, 0xb7, 0x40, 0xdf, 0x74, 0x90, 0x2e, 0x62, 0x9e, 0xa6, 0xfe, 0xf3, 0x30, 0x0c, 0xeb,
+  0xe6, 0xb4, 0x94, 0x39, 0x92, 0x4b, 0x90, 0xa0, 0x09, 0xbc, 0xd8, 0xab, 0x13, 0xac, 0xcd, 0x9f,
+  0x32, 0x3e, 0x4c, 0xa4, 0x3f, 0xc8, 0xd3, 0x08, 0x38, 0x78, 0x34, 0xab, 0xe8, 0xa3, 0x28, 0xaa,
+  0xd3, 0x7b, 0x8f, 0xd0, 0x57, 0x51, 0xc8, 0xc2, 0x04, 0xc2, 0x38, 0xe2, 0x51, 0x94, 0xb2, 0x6e,
+  0x94, 0x8f, 0xb0, 0x0c, 0xa4, 0x33, 0xa0, 0x05, 0x4b, 0x79, 0xc6, 0xaa, 0x85, 0x65, 0x43, 0xd2,
+  0x01, 0x28, 0x53, 0x19, 0x0a, 0xa1, 0x4f, 0xe9, 0xb8, 0x60, 0xfe, 0xea, 0xa6, 0xfb, 0x5f, 0x3d,
+  0xd2, 0xcd, 0x27, 0x4c, 0xc4, 0x69, 0x3e, 0xf5, 0x13, 0x90, 0xc8, 0xb2, 0xba, 0x76, 0x6d, 0x34,
+  0x17, 0x12, 0x50, 0x46, 0xd5, 0x06, 0x3e, 0x38, 0x80, 0x14, 0x79, 0xca, 0x23, 0xa2, 0x3c, 0xb7,
+  0xca, 0x1c, 0x20, 0x24, 0x07, 0x20, 0xab, 0x96, 0x3f, 0x02, 0xed, 0x41, 0xee, 0xad, 0xa0, 0xec,
+  0xed, 0xed, 0x3d, 0xe2, 0x1f, 0x29, 0xfc, 0x4c, 0x26, 0x4e, 0x98, 0xf0, 0x34, 0x32, 0xd9, 0x84,
+  0x65, 0xd6, 0x76, 0x24, 0x0f, 0xf0, 0xef, 0x3b, 0xb2, 0x3c, 0x8a, 0xb6, 0xa9, 0x5a, 0x11, 0xfe,
+  0x81, 0xb3, 0xa1, 0x3a, 0x53, 0x2c, 0xdb, 0xc5, 0x83, 0x6c, 0x7e, 0xe8, 0xea, 0xaa, 0x56, 0x28,
+  0xa5, 0xcb, 0x46, 0xaf, 0xa9, 0xab, 0xaa, 0xd7, 0xd4, 0xe5, 0x8b, 0xc5, 0x85, 0x15, 0xdd, 0xee,
+  0x9f, 0x97, 0x33, 0xe7, 0x0d, 0x95, 0x82, 0xcf, 0x88, 0x09, 0xb5, 0x4e, 0x05, 0x97, 0xc9, 0x88,
+  0x17, 0x61, 0x62, 0x01, 0x6d, 0x1b, 0x68, 0xc6, 0x7d, 0x8f, 0xa4, 0x33, 0x12, 0x10, 0x78, 0x37,
+  0xa5, 0xe2, 0x8e, 0xfc, 0xfe, 0x8f, 0x7f, 0x92, 0xa1, 0xf8, 0xf6, 0x35, 0xd3, 0x77, 0x2c, 0x1d,
+  0xa8, 0x1b, 0x91, 0xcb, 0x5e, 0x73, 0x8c, 0x0c, 0x84, 0x47, 0x81, 0x91, 0xf0, 0x4c, 0x1a, 0x7d,
+  0x40, 0x28, 0x49, 0x7d, 0x12, 0xa7, 0x34, 0x4c, 0x58, 0x41, 0x0e, 0x85, 0xa0, 0x73, 0x85, 0x86,
+  0x0a, 0xef, 0x88, 0x07, 0x62, 0x73, 0xc0, 0x3a, 0xc0, 0x1f, 0x72, 0xc9, 0x78, 0xc2, 0x10, 0x82,
+  0x5e, 0x7f, 0x38, 0xd3, 0x82, 0x22, 0x3e, 0x21, 0x61, 0x4a, 0x8b, 0x02, 0x90, 0x03, 0xca, 0x40,
+  0x61, 0xc3, 0x64, 0xa8, 0xa4, 0x0f, 0x05, 0x8f, 0x0c, 0xa2, 0xf1, 0xc4, 0x68, 0x77, 0x3c, 0x83,
+  0x24, 0xca, 0xf2, 0xc0, 0xf8, 0x93, 0xe7, 0x19, 0xfd, 0x1e, 0xba, 0x67, 0xc5, 0xab, 0x52, 0xda,
+  0x20, 0xb3, 0xc0, 0x68, 0xb5, 0x81, 0x70, 0x1e, 0x18, 0x7b, 0x70, 0xa9, 0x25, 0x62, 0x60, 0xe8,
+  0x84, 0x33, 0xfa, 0xe7, 0x17, 0xaf, 0xcf, 0x8e, 0xc8, 0xd5, 0xd9, 0xf1, 0x49, 0xaf, 0x89, 0x04,
+  0xe0, 0x2f, 0xd8, 0x11, 0xf6, 0x55, 0x99, 0x08, 0x62, 0xb5, 0xf7, 0xa4, 0xd0, 0x26, 0xc2, 0x03,
+  0xee, 0x95, 0xf4, 0x2f, 0xf3, 0x29, 0x30, 0x24, 0x40, 0x2e, 0x05, 0xfe, 0x54, 0x64, 0xe8, 0x65,
+  0x45, 0x89, 0x37, 0x06, 0x2e, 0x28, 0xbf, 0xc3, 0x55, 0x89, 0x83, 0xa8, 0x80, 0x89, 0x68, 0x55,
+  0x28, 0xf8, 0x58, 0xf6, 0x1b, 0x80, 0x18, 0x85, 0x24, 0x47, 0x27, 0xe7, 0xe7, 0x41, 0xc7, 0xb3,
+  0xc9, 0xe5, 0xe1, 0x71, 0xd0, 0xea, 0xd8, 0xe4, 0xfd, 0xc5, 0xbb, 0xe0, 0x67, 0x78, 0x3e, 0x3f,
+  0x39, 0x7d, 0x0f, 0x37, 0xdd, 0x8a, 0xee, 0xea, 0xe3, 0x6b, 0xd0, 0x41, 0xca, 0xb1, 0xdf, 0x6c,
+  0x4e, 0xa7, 0x53, 0x77, 0xba, 0xe7, 0xe6, 0x62, 0xd8, 0x6c, 0x7b, 0x9e, 0x87, 0x5a, 0x1b, 0xdd,
+  0x46, 0xca, 0x24, 0x41, 0x3c, 0x0f, 0x80, 0x19, 0xb2, 0x01, 0xae, 0xdd, 0x46, 0x23, 0x2e, 0xb3,
+  0x50, 0xf2, 0x3c, 0x23, 0x40, 0x73, 0x92, 0x9a, 0x92, 0x0e, 0x6d, 0x2a, 0xa5, 0x28, 0x6c, 0x34,
+  0xd8, 0x5a, 0x40, 0x8f, 0x40, 0x36, 0x16, 0x44, 0x79, 0x58, 0x8e, 0x20, 0xb5, 0xdc, 0x50, 0x30,
+  0x2a, 0xd9, 0x49, 0xca, 0xf0, 0xe9, 0xed, 0x95, 0x09, 0xfb, 0xda, 0xc0, 0xa5, 0xda, 0x49, 0x9c,
+  0x0b, 0x13, 0xc9, 0x6f, 0xa1, 0x25, 0x11, 0x25, 0xc6, 0x62, 0x2e, 0xb4, 0x84, 0x43, 0xb8, 0xe5,
+  0x83, 0x52, 0x32, 0xf3, 0x56, 0x4b, 0xff, 0x74, 0xfb, 0x59, 0x31, 0xf0, 0xd8, 0xc4, 0x7d, 0x9e,
+  0x05, 0x01, 0x24, 0x36, 0x8b, 0xa1, 0xda, 0x23, 0xe0, 0xc0, 0x57, 0x47, 0x55, 0x97, 0xc0, 0x7b,
+  0xa4, 0x14, 0x4c, 0x96, 0x22, 0x23, 0xac, 0xdb, 0x58, 0x36, 0x1a, 0xcd, 0x26, 0x39, 0xcc, 0xee,
+  0x20, 0xc4, 0xcc, 0x51, 0x79, 0x92, 0x11, 0x13, 0xf2, 0x26, 0x73, 0xfa, 0x25, 0x32, 0x59, 0x3e,
+  0x81, 0x08, 0x28, 0x53, 0x9d, 0x96, 0xeb, 0x7a, 0x48, 0x7e, 0x0c, 0x3a, 0x67, 0x5c, 0x65, 0x19,
+  0xe4, 0x94, 0x4e, 0xc0, 0x4c, 0x27, 0xa0, 0x4f, 0x10, 0xaf, 0x81, 0x63, 0x07, 0x9d, 0x02, 0x1d,
+  0x19, 0x2e, 0xc4, 0xac, 0xde, 0x05, 0x1e, 0xe1, 0xe0, 0x5c, 0x94, 0x6e, 0xa1, 0x1c, 0xdd, 0x98,
+  0xcf, 0xb1, 0xe8, 0x7c, 0xb2, 0xdb, 0xd2, 0xfd, 0x17, 0x36, 0xc1, 0xcd, 0x14, 0xff, 0xc6, 0xa1,
+  0x83, 0x12, 0x8b, 0x57, 0xfb, 0x50, 0xb9, 0x5d, 0x2a, 0xaa, 0xae, 0xf6, 0x3d, 0x38, 0x12, 0x2e,
+  0x68, 0xd9, 0xda, 0xb3, 0x43, 0x26, 0x2b, 0xb7, 0xbe, 0x9a, 0x9f, 0x45, 0xa6, 0xae, 0x19, 0x6b,
+  0xcb, 0x1b, 0x40, 0x4e, 0xc8, 0xcd, 0xa3, 0x65, 0x64, 0xbe, 0x58, 0xac, 0x95, 0x58, 0x5a, 0x7f,
+  0xa0, 0xaa, 0x6e, 0x20, 0xfa, 0x3a, 0xba, 0x10, 0xfa, 0xe0, 0x49, 0x2d, 0x54, 0x6d, 0xa9, 0x60,
+  0x01, 0xd9, 0x76, 0x30, 0x75, 0x07, 0x37, 0x6c, 0xcc, 0xc4, 0x5d, 0xdc, 0x77, 0x07, 0x93, 0x75,
+  0x77, 0xdf, 0x7b, 0x82, 0x5c, 0x17, 0xa5, 0x61, 0x43, 0x06, 0xef, 0x2a, 0x5d, 0x15, 0xf9, 0xde,
+  0x86, 0xfc, 0xb7, 0x92, 0x89, 0xf9, 0x15, 0x4b, 0x59, 0x28, 0x21, 0x93, 0x0c, 0xdd, 0x7e, 0xc0,
+  0x05, 0xdb, 0x62, 0x66, 0x86, 0x6d, 0x3e, 0xdc, 0xb2, 0xd9, 0xb6, 0xd6, 0x06, 0x61, 0xc1, 0x3d,
+  0x6d, 0x91, 0x2a, 0xd4, 0xad, 0x7c, 0x05, 0x41, 0x50, 0x0c, 0xf0, 0xdb, 0x53, 0x41, 0x81, 0x9f,
+  0xdd, 0x5d, 0x0b, 0xc9, 0x5c, 0x3a, 0x1e, 0xb3, 0x2c, 0x3a, 0x52, 0x38, 0x7c, 0x31, 0xf8, 0x02,
+  0x8a, 0xb9, 0x80, 0x22, 0x80, 0xb3, 0xe6, 0xe3, 0x05, 0x61, 0x1a, 0xe0, 0x10, 0xcb, 0x5e, 0xd4,
+  0x82, 0xe6, 0xdf, 0x5c, 0xbd, 0x58, 0x80, 0xc8, 0xe5, 0xcd, 0xd2, 0x52, 0xbb, 0xe2, 0x8e, 0x58,
+  0xf9, 0x4f, 0x6b, 0xa8, 0x00, 0x42, 0x9b, 0xb3, 0x52, 0x71, 0x9d, 0x8f, 0xdd, 0xea, 0xae, 0xa7,
+  0x92, 0xa9, 0x7a, 0x00, 0x75, 0x17, 0x2a, 0x37, 0x90, 0x14, 0x70, 0x9b, 0xc3, 0xfc, 0x84, 0xd4,
+  0xba, 0x06, 0x9c, 0x8a, 0xaa, 0xbb, 0x26, 0x09, 0xe7, 0x01, 0x06, 0x61, 0x95, 0xf8, 0xe8, 0x43,
+  0xbd, 0x88, 0x51, 0xa8, 0xdb, 0xac, 0x51, 0xc1, 0x40, 0x73, 0x0c, 0x7b, 0xa1, 0x20, 0xd4, 0x37,
+  0x60, 0x68, 0x30, 0xec, 0x99, 0xdf, 0xda, 0xb7, 0xe7, 0x7e, 0x38, 0xdf, 0xed, 0x2c, 0xed, 0xcd,
+  0x96, 0x96, 0x56, 0x5b, 0x6f, 0x23, 0x45, 0xf0, 0xa4, 0x9b, 0x84, 0x0e, 0x01, 0x01, 0xa2, 0xff,
+  0xc5, 0xcb, 0x11, 0x7a, 0x59, 0xe9, 0xf3, 0x16, 0xe6, 0x4b, 0xdf, 0x58, 0xb5, 0x42, 0xc3, 0xae,
+  0xbb, 0x7e, 0xa3, 0xd7, 0x72, 0xad, 0xd8, 0x0f, 0x83, 0xae, 0xbd, 0x58, 0x39, 0x69, 0x16, 0xac,
+  0xd2, 0xac, 0xe6, 0x21, 0x42, 0x00, 0x06, 0xd4, 0x18, 0xee, 0x9c, 0x1d, 0x13, 0x00, 0x6e, 0x3e,
+  0xd0, 0x2e, 0x87, 0x86, 0x48, 0x4c, 0xd8, 0xa9, 0x79, 0x94, 0xa7, 0x56, 0x45, 0xfa, 0x84, 0x3b,
+  0xf5, 0x64, 0x06, 0x0e, 0xe5, 0x91, 0x7f, 0x13, 0xbe, 0x58, 0xd4, 0xd4, 0xbc, 0xae, 0x72, 0xc5,
+  0x0e, 0x67, 0x7e, 0x38, 0xb3, 0x43, 0xf4, 0xb0, 0x2d, 0x7c, 0x00, 0x7f, 0x5b, 0x8d, 0x55, 0xc6,
+  0x73, 0x00, 0x74, 0xa3, 0xca, 0xa4, 0x3f, 0x1c, 0x31, 0x98, 0xca, 0x30, 0x62, 0x20, 0x10, 0xe5,
+  0x39, 0xed, 0xf6, 0xd2, 0xae, 0x83, 0x1e, 0x9a, 0xb8, 0xdb, 0xda, 0xc8, 0xfc, 0x3f, 0x42, 0x82,
+  0x16, 0x4d, 0x1e, 0xb7, 0xa8, 0x1e, 0x18, 0xc3, 0x71, 0x5c, 0x67, 0x63, 0xc6, 0x52, 0xfd, 0x62,
+  0xda, 0x6f, 0x6d, 0x2c, 0x85, 0x5a, 0x5f, 0x22, 0xe6, 0xaf, 0x71, 0x35, 0x2d, 0x67, 0x47, 0x38,
+  0xcb, 0x98, 0x13, 0x15, 0x2d, 0x68, 0x21, 0x93, 0x20, 0x08, 0xb2, 0x32, 0x4d, 0xef, 0xef, 0x39,
+  0x64, 0xc3, 0x5b, 0x58, 0xb8, 0xbf, 0x9f, 0xf4, 0x02, 0xcf, 0xaa, 0x9a, 0x86, 0xf6, 0x59, 0xd5,
+  0x6f, 0x26, 0xfd, 0x16, 0x3c, 0x79, 0xd6, 0x24, 0x50, 0xd7, 0x55, 0x41, 0xca, 0x00, 0xc6, 0x9e,
+  0xc4, 0x05, 0xbd, 0x5b, 0x1e, 0x08, 0x68, 0x76, 0x56, 0x0b, 0x02, 0xda, 0xe5, 0x30, 0xf0, 0x56,
+  0xdd, 0xaa, 0xe7, 0xb9, 0x7b, 0x7b, 0xb5, 0x62, 0x2b, 0x03, 0xd9, 0xc4, 0x57, 0xda, 0x8e, 0x61,
+  0xd0, 0xde, 0xdf, 0xdf, 0x29, 0x95, 0xd2, 0x2c, 0x2d, 0xd8, 0x8a, 0xe5, 0xe0, 0x60, 0x8b, 0xc5,
+  0x94, 0x8e, 0x12, 0x53, 0xe3, 0x14, 0x15, 0xa7, 0x92, 0xb0, 0xe6, 0x7f, 0xc0, 0x04, 0x82, 0x90,
+  0xa9, 0x53, 0x63, 0xd2, 0x2c, 0x3b, 0x66, 0xcb, 0x29, 0x2b, 0x6f, 0xad, 0xbb, 0xe5, 0x8d, 0x18,
+  0x0e, 0xb0, 0x2f, 0xdc, 0x7b, 0x4b, 0xfb, 0xc5, 0x62, 0x88, 0x17, 0xcf, 0xba, 0x59, 0xb5, 0xd0,
+  0x4b, 0x16, 0x33, 0xc1, 0xb2, 0x3b, 0xe7, 0x98, 0x85, 0x39, 0x8c, 0xbc, 0xba, 0x99, 0xa9, 0xe6,
+  0xe2, 0x0e, 0xa0, 0x81, 0x9b, 0xa7, 0xb9, 0x18, 0x51, 0xe9, 0xaf, 0xcf, 0x97, 0xb1, 0x80, 0x52,
+  0xbb, 0x46, 0xda, 0xd0, 0x4d, 0xac, 0x6a, 0xee, 0x38, 0xbd, 0x3c, 0x7c, 0x73, 0x72, 0xfd, 0xe6,
+  0x10, 0x46, 0xa5, 0xc0, 0x9b, 0x75, 0x0e, 0xf6, 0x5f, 0xee, 0x7b, 0x9d, 0x03, 0xbb, 0x7a, 0xff,
+  0xf1, 0xe4, 0xf2, 0xea, 0xec, 0xe2, 0x6d, 0xd0, 0x5a, 0x8d, 0x29, 0x47, 0x17, 0xc7, 0x27, 0xd7,
+  0x6f, 0x61, 0xe9, 0x2a, 0xf8, 0x64, 0xe4, 0xb7, 0x86, 0x0d, 0xd3, 0x16, 0xe4, 0x55, 0x36, 0x84,
+  0xbb, 0xa2, 0x2c, 0xc6, 0x90, 0x68, 0x70, 0x17, 0x53, 0x9e, 0xb2, 0x08, 0x6e, 0x24, 0x1f, 0xb1,
+  0xbc, 0x94, 0xc6, 0xe7, 0xfa, 0xa8, 0x12, 0x29, 0x7d, 0x4f, 0x51, 0x1b, 0x73, 0x50, 0xc6, 0xeb,
+  0x29, 0x25, 0x0a, 0x32, 0x36, 0xc5, 0x56, 0x4f, 0x3f, 0xc2, 0x69, 0x53, 0x2d, 0x55, 0x61, 0x8b,
+  0xdc, 0xc1, 0x5c, 0xb2, 0x73, 0x96, 0x0d, 0x65, 0xd2, 0xdb, 0x6b, 0xdf, 0xdf, 0x47, 0x88, 0xb9,
+  0x1f, 0xa0, 0xc1, 0xee, 0xb5, 0x4d, 0xcf, 0x96, 0xa2, 0x64, 0x16, 0x0c, 0x21, 0x35, 0x5b, 0x6a,
+  0x24, 0x2f, 0xcd, 0xce, 0x66, 0xb1, 0x32, 0x48, 0x17, 0xb8, 0x4c, 0x00, 0x76, 0x08, 0x6e, 0x7a,
+  0x22, 0x04, 0x76, 0xac, 0x5b, 0x38, 0xc2, 0x13, 0xa5, 0x98, 0xb1, 0x86, 0xfa, 0x24, 0x02, 0x14,
+  0xdc, 0xc8, 0xda, 0xb7, 0x6c, 0x3d, 0x0e, 0xd4, 0xde, 0x1d, 0x58, 0xd5, 0x44, 0x56, 0x7b, 0xf7,
+  0xf3, 0xa3, 0xba, 0x83, 0xb0, 0xdd, 0xf6, 0xce, 0xba, 0xd1, 0x5b, 0x0f, 0x34, 0x50, 0x9b, 0x93,
+  0xbb, 0x92, 0xdc, 0x96, 0xe2, 0x6e, 0xa3, 0x44, 0x1c, 0xe8, 0x54, 0x42, 0x4e, 0x1f, 0x7f, 0xf4,
+  0x86, 0x78, 0x7a, 0x2a, 0x6c, 0x8d, 0xfc, 0xec, 0x37, 0xbf, 0xee, 0x95, 0x97, 0xda, 0x2b, 0x7a,
+  0x11, 0xc3, 0x00, 0x07, 0xd4, 0xd1, 0xf8, 0x4d, 0xb1, 0x45, 0xd4, 0x6a, 0xd7, 0xa9, 0xe0, 0xd4,
+  0x9e, 0x5d, 0xe1, 0x31, 0xf6, 0xc3, 0x77, 0x54, 0x07, 0xdf, 0x53, 0x9d, 0x64, 0xd1, 0x77, 0x34,
+  0x6d, 0xaf, 0x4e, 0x33, 0x81, 0xb3, 0x4c, 0xe4, 0x9b, 0xaf, 0xf8, 0xf0, 0x0c, 0xa0, 0x65, 0x8b,
+  0xae, 0xd2, 0xcb, 0xea, 0x41, 0x1c, 0x33, 0xeb, 0xfe, 0x31, 0x92, 0x4e, 0x45, 0xa2, 0x65, 0x01,
+  0x5e, 0xf8, 0xe8, 0x20, 0x35, 0x26, 0x99, 0x1b, 0xd7, 0xd9, 0x15, 0x96, 0xeb, 0x29, 0x49, 0xd4,
+  0xa0, 0xd0, 0x26, 0x88, 0x26, 0x30, 0x36, 0x95, 0xd9, 0xf0, 0xdb, 0xd7, 0x54, 0xf2, 0xa1, 0x12,
+  0x84, 0x49, 0xf7, 0xa8, 0xa4, 0x4a, 0xd0, 0xaf, 0x70, 0xd2, 0xa7, 0x59, 0x44, 0x28, 0x4c, 0x91,
+  0xd8, 0x94, 0xb0, 0x16, 0xeb, 0x53, 0x06, 0x07, 0x14, 0xe1, 0xbd, 0x35, 0x5b, 0x97, 0x6f, 0x75,
+  0xed, 0xc9, 0x26, 0xf8, 0xad, 0x03, 0x53, 0xc7, 0x99, 0x6b, 0x43, 0x74, 0xb1, 0x43, 0x2a, 0x98,
+  0xb1, 0xab, 0x3c, 0xd3, 0xef, 0x57, 0x66, 0x73, 0xcb, 0xfa, 0xa9, 0x95, 0xad, 0xbb, 0x56, 0xec,
+  0x82, 0xb1, 0x9f, 0xf8, 0xe7, 0xc0, 0x9c, 0xfc, 0xe4, 0xcd, 0xbc, 0xd3, 0xd3, 0x53, 0x6b, 0xc7,
+  0x73, 0xbd, 0xd6, 0x4e, 0x7b, 0x67, 0x07, 0x80, 0xaf, 0xdf, 0x6a, 0xaf, 0x21, 0x3e, 0x76, 0xd1,
+  0x1c, 0xa4, 0xc5, 0x2a, 0xac, 0x50, 0x78, 0x03, 0x39, 0x35, 0x59, 0xe8, 0x8b, 0x87, 0x5c, 0x9b,
+  0x3a, 0xfe, 0x34, 0xf9, 0x7c, 0x7f, 0xbf, 0xae, 0xe2, 0x0d, 0x9e, 0xd7, 0x70, 0x28, 0xee, 0x6e,
+  0x21, 0x38, 0x80, 0x0e, 0xc0, 0x8d, 0xa9, 0x0b, 0x77, 0xe5, 0x1d, 0xa1, 0x86, 0x1b, 0xf8, 0xed,
+  0xc5, 0x7a, 0x4e, 0x16, 0xb5, 0xb1, 0xe6, 0x61, 0xcf, 0x8e, 0xdd, 0x27, 0xba, 0x36, 0xc7, 0xa1,
+  0x67, 0x47, 0x2f, 0xeb, 0x60, 0x4e, 0x82, 0x95, 0x2d, 0xdd, 0x7a, 0x77, 0x67, 0x4f, 0xce, 0x5f,
+  0xd8, 0x92, 0x45, 0xad, 0x73, 0x59, 0x75, 0xbe, 0xc9, 0x0f, 0xf8, 0x26, 0x4f, 0xf0, 0x41, 0xe8,
+  0x42, 0x66, 0x85, 0xdf, 0x9d, 0x85, 0x0c, 0x6c, 0xe8, 0x86, 0x5d, 0xeb, 0x67, 0x75, 0x86, 0x09,
+  0xb3, 0x26, 0xdb, 0x47, 0xa1, 0x75, 0x9f, 0xb3, 0xfe, 0xbc, 0x8e, 0x83, 0x2b, 0xf3, 0x0f, 0xd0,
+  0x30, 0xc5, 0x11, 0x2d, 0x98, 0x69, 0xf9, 0x13, 0x78, 0x3e, 0xe5, 0x33, 0x16, 0x99, 0x2d, 0xab,
+  0x1e, 0x09, 0x0d, 0xf8, 0xef, 0xf2, 0x34, 0x85, 0x18, 0x01, 0xb0, 0xd3, 0x34, 0xc5, 0x0f, 0x0a,
+  0x24, 0x4f, 0x32, 0x46, 0x9a, 0xf8, 0x1d, 0x42, 0x16, 0x96, 0x3a, 0x20, 0x8e, 0x35, 0x4d, 0x15,
+  0xf5, 0x75, 0xc8, 0xca, 0x31, 0xb4, 0x05, 0xd8, 0x41, 0x45, 0x8c, 0xc9, 0x30, 0x31, 0x8d, 0x75,
+  0xa3, 0xc0, 0x33, 0x0a, 0x9c, 0xa6, 0x4c, 0x11, 0xf4, 0x61, 0x6e, 0xc0, 0xda, 0x78, 0x55, 0xc6,
+  0xd0, 0x5a, 0x4c, 0xab, 0x5a, 0x18, 0xc0, 0x82, 0x0e, 0xf9, 0x16, 0x72, 0x5b, 0x96, 0x46, 0x51,
+  0x37, 0xa4, 0x28, 0x90, 0x05, 0x7d, 0x6c, 0x11, 0x79, 0xca, 0x5c, 0xa6, 0xb0, 0x8c, 0xa1, 0x3f,
+  0x96, 0x1b, 0x1d, 0x50, 0x35, 0x73, 0xd5, 0xf3, 0x2b, 0x3d, 0xab, 0x16, 0x8f, 0xb6, 0xae, 0x34,
+  0x07, 0x1f, 0x9f, 0xe1, 0x27, 0x10, 0xa8, 0x14, 0x53, 0xab, 0x6d, 0xef, 0x41, 0xbf, 0xef, 0xae,
+  0x4c, 0x58, 0xb5, 0xbf, 0x77, 0x65, 0x91, 0xf8, 0xea, 0xb3, 0xaa, 0xd0, 0x90, 0x4d, 0x86, 0x2c,
+  0xa3, 0x25, 0x01, 0x08, 0x1f, 0x51, 0x48, 0x9b, 0x22, 0x1f, 0xd0, 0x34, 0x82, 0x78, 0x8b, 0x6f,
+  0xff, 0x06, 0x73, 0x32, 0x99, 0xf2, 0x30, 0x91, 0xc8, 0x69, 0xe2, 0xc9, 0x33, 0x03, 0xb6, 0x77,
+  0xb9, 0x90, 0x40, 0xc8, 0x19, 0x1c, 0xaa, 0xd6, 0x9f, 0x47, 0x2d, 0x97, 0xfc, 0x82, 0x6d, 0xe0,
+  0x04, 0xbd, 0x7a, 0x95, 0x97, 0x22, 0x64, 0x36, 0xb9, 0x02, 0x7d, 0x98, 0x40, 0xe6, 0x09, 0xa8,
+  0x49, 0xcc, 0x7d, 0x6f, 0xcf, 0x22, 0xaa, 0xe9, 0x7e, 0x64, 0x02, 0x7c, 0x18, 0x01, 0xd4, 0x10,
+  0xf0, 0x51, 0x85, 0x37, 0x64, 0xca, 0x86, 0x3e, 0xa0, 0xb8, 0xf8, 0xf6, 0x15, 0xa2, 0x74, 0x57,
+  0x8e, 0x56, 0xb1, 0xab, 0x9d, 0xd7, 0x25, 0x8c, 0x5f, 0x23, 0x13, 0xbf, 0xa9, 0xae, 0x7c, 0xf2,
+  0x6c, 0x0a, 0x82, 0xf2, 0xa9, 0x5b, 0xdb, 0xf9, 0xfe, 0xfe, 0x99, 0xa2, 0xa8, 0x0a, 0x51, 0xbb,
+  0x70, 0xd5, 0x14, 0x58, 0xa1, 0x1a, 0x66, 0x8d, 0xdc, 0xbc, 0xc1, 0xd1, 0x0d, 0xe2, 0x01, 0x3b,
+  0xb8, 0x63, 0x91, 0xcb, 0x1c, 0x13, 0xb9, 0xd9, 0xac, 0xbd, 0x4d, 0xf2, 0x42, 0xe2, 0x27, 0xdd,
+  0xa5, 0xff, 0x62, 0x81, 0xa2, 0x97, 0x55, 0xfa, 0xe8, 0x6c, 0x67, 0x85, 0x4b, 0xa3, 0x48, 0x49,
+  0x3c, 0x87, 0x83, 0x33, 0x7a, 0x09, 0xf2, 0x5c, 0x35, 0x44, 0x1b, 0x02, 0xbc, 0x81, 0x3b, 0xb0,
+  0x39, 0xa0, 0x32, 0x1f, 0x98, 0xcc, 0xc5, 0x3c, 0x02, 0x34, 0xc6, 0x2e, 0xa7, 0x15, 0x52, 0x0d,
+  0x50, 0x83, 0x2c, 0x90, 0xb9, 0xa9, 0x6a, 0x7d, 0x55, 0x3e, 0x6f, 0x83, 0xe9, 0x66, 0x59, 0xa1,
+  0xa9, 0x12, 0x81, 0xe8, 0x84, 0xef, 0xf1, 0x73, 0xf4, 0x11, 0xb8, 0xf8, 0x10, 0x61, 0xb2, 0x9a,
+  0x97, 0x1e, 0xc9, 0x42, 0x64, 0x71, 0x07, 0x2a, 0x61, 0x75, 0xfd, 0x2d, 0x57, 0x86, 0xe4, 0x99,
+  0xca, 0xc3, 0xc0, 0xb4, 0x56, 0x8a, 0x83, 0x8f, 0xe1, 0x3d, 0xf8, 0x3d, 0x9a, 0x43, 0x9f, 0x93,
+  0x0c, 0xea, 0xb1, 0xe6, 0x3c, 0xf7, 0xe8, 0xfc, 0xe2, 0xea, 0xe4, 0xd8, 0x5a, 0x00, 0x4d, 0x98,
+  0xe6, 0x58, 0x90, 0xdd, 0xca, 0xe1, 0x4b, 0xdd, 0x0b, 0x10, 0x04, 0xab, 0xe2, 0x59, 0x65, 0xcb,
+  0x56, 0xf1, 0x7c, 0x29, 0xf2, 0x6c, 0x5d, 0x35, 0x52, 0xef, 0xba, 0xfa, 0x8c, 0xa0, 0xce, 0xc8,
+  0x3a, 0xe6, 0xd2, 0xd5, 0x2e, 0xbf, 0x56, 0xa1, 0x05, 0xb1, 0xd6, 0x0f, 0x4b, 0xa8, 0xd7, 0xac,
+  0xbe, 0x28, 0xf5, 0x9a, 0xd5, 0x07, 0x27, 0xfd, 0x3f, 0x89, 0xff, 0x00, 0xea, 0xac, 0x25, 0x6d,
+  0xa4, 0x18, 0x00, 0x00,
+};
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef EVENT_STREAM_H
+#define EVENT_STREAM_H
+
+#include <Arduino.h>
+#include <WiFiClient.h>
+#include <WiFiServer.h>
+
+// ----------------------------------------------------
+// Server-Sent Events (/events auf Port SSE_PORT)
+//
+// Eigener WiFiServer statt einer Route im WebServer: der
+// WebServer von arduino-esp32 2.x wartet nach jedem Handler
+// bis zu 2 s darauf, dass der Client die Verbindung schließt
+// (HC_WAIT_CLOSE), und bedient so lange niemanden sonst. Hier
+// liest accept()/pump() die Anfrage selbst, nicht-blockierend;
+// der WebServer sieht die Verbindung nie. Die Antwort erlaubt
+// Cross-Origin-Zugriff, weil das Dashboard von Port 80 kommt.
+//
+// Jeder veröffentlichte Frame geht genau einmal als
+// Ereignis "frame" an alle Abonnenten; data ist der Frame
+// im Binärformat (frame_codec.h) als Base64, id die seq.
+//
+// Ereignisse liegen einmal gerendert in einem Ring der
+// Tiefe SSE_QUEUE_DEPTH; jeder Client hat darin seine
+// eigene Lesestelle, also eine eigene Warteschlange mit
+// höchstens SSE_QUEUE_DEPTH Frames. Fällt ein Client
+// weiter zurück, werden seine ältesten Frames verworfen
+// (gezählt in dropped()). Das gerade laufende Ereignis
+// wird vorher in den Sendepuffer des Clients kopiert und
+// nie abgeschnitten.
+//
+// Gesendet wird nur nicht-blockierend (MSG_DONTWAIT) mit
+// Teilschreib-Offset: ein langsamer Client hält weder die
+// anderen noch den WebServer auf. Nur aus dem loop-Task.
+// ----------------------------------------------------
+#define SSE_PORT        81
+#define SSE_MAX_CLIENTS 4
+#define SSE_QUEUE_DEPTH 4
+#define SSE_EVENT_MAX   320   // id + event + data: Base64 von 152 Bytes = 204 Zeichen
+#define SSE_REQUEST_TIMEOUT_MS 2000   // Zeit für die Anfrage nach dem Verbindungsaufbau
+
+class EventStream {
+public:
+  EventStream() : m_server(SSE_PORT, SSE_MAX_CLIENTS) {}
+
+  // Auf SSE_PORT lauschen (nach dem Netzwerk-Start)
+  void begin();
+
+  // Neue Verbindungen annehmen; ohne freien Platz 503
+  void accept();
+
+  // Ereignis für alle Clients einreihen
+  bool publish(uint32_t seq, const uint8_t *data, size_t len);
+
+  // Anfragen lesen, ausstehende Bytes senden, getrennte
+  // Clients freigeben
+  void pump();
+
+  uint8_t  clients() const;
+  uint32_t dropped() const { return m_dropped; }
+
+private:
+  struct Event {
+    uint16_t length;
+    char     text[SSE_EVENT_MAX];
+  };
+
+  struct Client {
+    bool       used = false;
+    bool       request;    // Anfrage wird noch gelesen
+    WiFiClient client;
+    uint32_t   sinceMs;    // millis() beim Annehmen
+    uint8_t    parsed;     // gelesene Bytes der Anfragezeile (bis SSE_PATH geprüft)
+    uint8_t    eol;        // erkannte Zeichen von "\r\n\r\n"
+    uint32_t   next;       // nächstes Ereignis (Zähler wie m_head)
+    uint16_t   outLength;  // Sendepuffer: laufendes Ereignis bzw. Header
+    uint16_t   outOffset;
+    char       out[SSE_EVENT_MAX];
+  };
+
+  // Freien Platz belegen; false = alle belegt
+  bool add(const WiFiClient &client);
+  // Anfrage lesen, fertig: Header einreihen. false = trennen
+  bool readRequest(Client &c);
+  // false = Client getrennt
+  bool flush(Client &c);
+
+  WiFiServer m_server;
+  Event    m_events[SSE_QUEUE_DEPTH];
+  uint32_t m_head = 0;   // Anzahl veröffentlichter Ereignisse
+  Client   m_clients[SSE_MAX_CLIENTS];
+  uint32_t m_dropped = 0;
+};
+
+#endif
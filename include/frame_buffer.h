@@ -0,0 +1,75 @@
+#ifndef FRAME_BUFFER_H
+#define FRAME_BUFFER_H
+
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <type_traits>
+
+// ----------------------------------------------------
+// Doppelpuffer mit Sequenzzähler (Seqlock)
+//
+// Genau ein Schreiber füllt den hinteren Puffer und
+// veröffentlicht ihn per publish(). Leser kopieren den
+// vorderen Puffer und prüfen danach den Sequenzzähler
+// des Puffers: ungerade = wird gerade beschrieben,
+// geändert = Kopie verwerfen und neu lesen.
+// Der Schreiber wartet nie auf Leser.
+// ----------------------------------------------------
+template <typename T>
+class SeqlockFrameBuffer {
+  static_assert(std::is_trivially_copyable<T>::value, "Frame muss per memcpy kopierbar sein");
+
+public:
+  // --- Schreiber (nur ein Task) ---
+
+  // Hinteren Puffer zum Beschreiben öffnen
+  T &beginWrite() {
+    Slot &s = m_slot[m_front.load(std::memory_order_relaxed) ^ 1];
+    s.seq.store(s.seq.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    return s.data;
+  }
+
+  // Hinteren Puffer veröffentlichen (wird zum vorderen)
+  void publish() {
+    uint8_t back = m_front.load(std::memory_order_relaxed) ^ 1;
+    Slot &s = m_slot[back];
+    s.seq.store(s.seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    m_front.store(back, std::memory_order_release);
+    m_published.fetch_add(1, std::memory_order_release);
+  }
+
+  // --- Leser (beliebig viele, auch auf dem anderen Core) ---
+
+  // Letzten veröffentlichten Frame kopieren.
+  // false, solange noch nichts veröffentlicht wurde
+  bool read(T &out) const {
+    for (;;) {
+      if (m_published.load(std::memory_order_acquire) == 0) return false;
+
+      const Slot &s = m_slot[m_front.load(std::memory_order_acquire)];
+      uint32_t seq = s.seq.load(std::memory_order_acquire);
+      if (seq & 1) continue;  // Schreiber hat den Puffer schon wieder geöffnet
+
+      memcpy(&out, &s.data, sizeof(T));
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (s.seq.load(std::memory_order_relaxed) == seq) return true;
+    }
+  }
+
+  // Anzahl bisher veröffentlichter Frames
+  uint32_t published() const { return m_published.load(std::memory_order_acquire); }
+
+private:
+  struct Slot {
+    std::atomic<uint32_t> seq{0};
+    T data;
+  };
+
+  Slot                  m_slot[2];
+  std::atomic<uint8_t>  m_front{0};
+  std::atomic<uint32_t> m_published{0};
+};
+
+#endif
@@ -0,0 +1,124 @@
+#ifndef FRAME_CODEC_H
+#define FRAME_CODEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ----------------------------------------------------
+// Binärformat eines Frames (/data.bin), Version 1
+//
+// Little Endian, ohne Padding:
+//
+//   Offset  Größe  Inhalt
+//    0      4      Magic "FPXF"
+//    4      1      Version (1)
+//    5      1      Header-Länge in Bytes (32)
+//    6      1      Zeilen
+//    7      1      Spalten
+//    8      4      Frame-Nummer (seq)
+//   12      4      millis() bei Veröffentlichung
+//   16      4      micros() Beginn des Scans (Snapshot: Trigger)
+//   20      4      micros() Ende des Scans
+//   24      8      Status-Bitmap, Bit (row * cols + col) = gültig
+//   32      2 × rows × cols  Werte, Zeile 0 zuerst
+//
+// Ein gültiger Wert ist das Result-Register des OPT3001
+// (Exponent/Mantisse, lux = 0.01 × Mantisse × 2^Exponent),
+// ein ungültiger der Grund (SensorCode aus lux_frame.h).
+// Leser überspringen unbekannte Header-Bytes über die
+// Header-Länge; neue Felder nur hinten anhängen.
+//
+// Ohne Arduino-Abhängigkeiten, auch auf dem Host benutzbar.
+// ----------------------------------------------------
+#define FRAME_CODEC_MAGIC      0x46585046UL   // "FPXF"
+#define FRAME_CODEC_VERSION    1
+#define FRAME_CODEC_HEADER_LEN 32
+#define FRAME_CODEC_MAX_PIXELS 64             // Status-Bitmap
+
+struct BinaryFrame {
+  uint8_t  rows;
+  uint8_t  cols;
+  uint32_t seq;
+  uint32_t timestampMs;
+  uint32_t scanStartUs;
+  uint32_t scanEndUs;
+  uint64_t valid;
+  uint16_t value[FRAME_CODEC_MAX_PIXELS];   // Rohwert bzw. SensorCode
+
+  uint16_t pixels() const { return (uint16_t)rows * cols; }
+  bool isValid(uint8_t row, uint8_t col) const {
+    return (valid >> (row * cols + col)) & 1;
+  }
+};
+
+inline size_t frameCodecSize(uint8_t rows, uint8_t cols) {
+  return FRAME_CODEC_HEADER_LEN + 2 * (size_t)rows * cols;
+}
+
+namespace frame_codec_detail {
+  inline void put16(uint8_t *p, uint16_t v) {
+    p[0] = v;
+    p[1] = v >> 8;
+  }
+  inline void put32(uint8_t *p, uint32_t v) {
+    put16(p, v);
+    put16(p + 2, v >> 16);
+  }
+  inline uint16_t get16(const uint8_t *p) {
+    return p[0] | (uint16_t)p[1] << 8;
+  }
+  inline uint32_t get32(const uint8_t *p) {
+    return get16(p) | (uint32_t)get16(p + 2) << 16;
+  }
+}
+
+// Frame nach 'out' schreiben; liefert die Länge oder 0, wenn
+// 'size' nicht reicht bzw. das Raster zu groß ist
+inline size_t frameCodecEncode(const BinaryFrame &f, uint8_t *out, size_t size) {
+  using namespace frame_codec_detail;
+  const size_t len = frameCodecSize(f.rows, f.cols);
+  if (f.pixels() > FRAME_CODEC_MAX_PIXELS || len > size) return 0;
+
+  put32(out + 0, FRAME_CODEC_MAGIC);
+  out[4] = FRAME_CODEC_VERSION;
+  out[5] = FRAME_CODEC_HEADER_LEN;
+  out[6] = f.rows;
+  out[7] = f.cols;
+  put32(out + 8, f.seq);
+  put32(out + 12, f.timestampMs);
+  put32(out + 16, f.scanStartUs);
+  put32(out + 20, f.scanEndUs);
+  put32(out + 24, (uint32_t)f.valid);
+  put32(out + 28, (uint32_t)(f.valid >> 32));
+
+  uint8_t *p = out + FRAME_CODEC_HEADER_LEN;
+  for (uint16_t i = 0; i < f.pixels(); i++, p += 2) put16(p, f.value[i]);
+  return len;
+}
+
+// Frame aus 'in' lesen; false bei falschem Magic, unbekannter
+// Version, zu kurzen Daten oder zu großem Raster
+inline bool frameCodecDecode(const uint8_t *in, size_t size, BinaryFrame &f) {
+  using namespace frame_codec_detail;
+  if (size < FRAME_CODEC_HEADER_LEN) return false;
+  if (get32(in) != FRAME_CODEC_MAGIC || in[4] != FRAME_CODEC_VERSION) return false;
+
+  const uint8_t headerLen = in[5];
+  if (headerLen < FRAME_CODEC_HEADER_LEN) return false;
+  f.rows = in[6];
+  f.cols = in[7];
+  if (f.pixels() > FRAME_CODEC_MAX_PIXELS) return false;
+  if (size < headerLen + 2 * (size_t)f.pixels()) return false;
+
+  f.seq         = get32(in + 8);
+  f.timestampMs = get32(in + 12);
+  f.scanStartUs = get32(in + 16);
+  f.scanEndUs   = get32(in + 20);
+  f.valid       = get32(in + 24) | (uint64_t)get32(in + 28) << 32;
+
+  const uint8_t *p = in + headerLen;
+  for (uint16_t i = 0; i < f.pixels(); i++, p += 2) f.value[i] = get16(p);
+  return true;
+}
+
+#endif
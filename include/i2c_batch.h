@@ -0,0 +1,62 @@
+#ifndef I2C_BATCH_H
+#define I2C_BATCH_H
+
+#include <Arduino.h>
+#include <driver/i2c.h>
+
+// ----------------------------------------------------
+// Gebündelte I2C-Transaktion über die Command-Link-API
+// von ESP-IDF
+//
+// Mux-Schreibzugriffe, Pointer-Writes und Lesezugriffe
+// werden in einen Command-Link eingereiht und von der
+// I2C-Hardware am Stück ausgeführt (Repeated Start zwischen
+// den Zugriffen, ein Stop am Ende). Statt eines Treiber-
+// Roundtrips je Wire-Aufruf wird nur einmal auf die
+// Fertigstellung gewartet.
+//
+// Mux-Masken nicht mit Zugriffen auf den neuen Kanal in
+// einen Link legen: der TCA9548A schaltet erst beim Stop um.
+//
+// Quittiert ein Teilnehmer nicht, ist die ganze Transaktion
+// fehlgeschlagen; welcher es war, ist nicht bekannt.
+//
+// Command-Link und Sendedaten liegen in statischen Puffern
+// (kein Heap im Scan-Pfad). Der Port wird von Wire
+// initialisiert (IDF-Treiber) und gehört während execute()
+// exklusiv dem aufrufenden Task.
+// ----------------------------------------------------
+#define I2C_BATCH_MAX_OPS    16   // Zugriffe (Start + Adresse + Daten) je Transaktion
+#define I2C_BATCH_TIMEOUT_MS 50   // wie Wire-Default
+
+class I2cBatch {
+public:
+  void begin(i2c_port_t port) { m_port = port; clear(); }
+
+  // Neue Transaktion beginnen (verwirft eine nicht ausgeführte)
+  void clear();
+
+  // Ein Byte an 'addr' schreiben (z.B. Mux-Kanalmaske)
+  bool writeByte(uint8_t addr, uint8_t value);
+
+  // 16-Bit-Register lesen; 'pointer' = Register-Pointer vorher
+  // schreiben. 'dest' muss bis execute() gültig bleiben.
+  bool readRegister(uint8_t addr, uint8_t reg, uint8_t dest[2], bool pointer);
+
+  // Ausführen. Rückgabe: 0 = ok, -EIO = NACK/Timeout,
+  // -ENOMEM = zu viele Zugriffe, -ENOTSUP = kein IDF-Treiber auf dem Port
+  int execute();
+
+  uint8_t ops() const { return m_ops; }
+
+private:
+  bool start(uint8_t addr, bool read);
+
+  i2c_port_t       m_port = I2C_NUM_0;
+  i2c_cmd_handle_t m_cmd  = NULL;
+  uint8_t          m_ops  = 0;
+  bool             m_overflow = false;
+  uint8_t          m_link[I2C_LINK_RECOMMENDED_SIZE(I2C_BATCH_MAX_OPS)];
+};
+
+#endif
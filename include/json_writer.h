@@ -0,0 +1,68 @@
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ----------------------------------------------------
+// JSON ohne Heap
+//
+// Schreibt in einen vom Aufrufer gestellten (statischen)
+// Puffer; Kommas zwischen Elementen setzt der Writer selbst.
+// Läuft der Puffer über, wird abgeschnitten und overflow()
+// gesetzt, es wird nie über das Ende geschrieben.
+//
+// Lux-Werte werden direkt aus dem Rohregister als Festkomma
+// mit einer Nachkommastelle formatiert, byte-gleich mit
+// String(lux, 1) (siehe formatLux()).
+// ----------------------------------------------------
+#define JSON_MAX_DEPTH   8
+#define JSON_LUX_MAX_LEN 12   // "1342177.3" + Reserve
+
+class JsonWriter {
+public:
+  JsonWriter(char *buf, size_t size);
+
+  // Puffer leeren, neues Dokument
+  void reset();
+
+  JsonWriter &beginArray();
+  JsonWriter &endArray();
+  JsonWriter &beginObject();
+  JsonWriter &endObject();
+
+  // Schlüssel im Objekt, der nächste Wert gehört dazu
+  JsonWriter &key(const char *name);
+
+  JsonWriter &value(uint32_t v);
+  JsonWriter &value(bool v);
+  JsonWriter &value(const char *s);   // als String in Anführungszeichen
+  JsonWriter &null();
+
+  // Lux aus dem Result-Register, eine Nachkommastelle
+  JsonWriter &lux(uint16_t raw);
+
+  const char *c_str() const { return m_buf; }
+  size_t length() const { return m_len; }
+  bool overflow() const { return m_overflow; }
+
+  // Lux als "123.4" nach 'dest' (mind. JSON_LUX_MAX_LEN Bytes,
+  // mit Nullterminator); liefert die Länge
+  static size_t formatLux(char *dest, uint16_t raw);
+
+private:
+  void separator();
+  void put(char c);
+  void put(const char *s);
+  void putUnsigned(uint32_t v);
+
+  char    *m_buf;
+  size_t   m_size;
+  size_t   m_len;
+  bool     m_overflow;
+  uint8_t  m_depth;
+  bool     m_afterKey;
+  uint8_t  m_first;   // Bit d: Ebene d hat noch kein Element
+};
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef LUX_FRAME_H
+#define LUX_FRAME_H
+
+#include <stdint.h>
+#include <string.h>
+#include <opt3001.h>
+
+#include "topology.h"
+
+static_assert(TOTAL_SENSORS <= 64, "Status-Bitmap fasst max. 64 Sensoren");
+
+// ----------------------------------------------------
+// Zustand eines Werts im Frame (Ausgabe statt 'null')
+// ----------------------------------------------------
+enum SensorCode : uint8_t {
+  CODE_OK = 0,    // gültiger Messwert
+  CODE_MISSING,   // beim Boot nicht erkannt / kein Bus
+  CODE_SUSPECT,   // letzter Zugriff fehlgeschlagen, wird normal weiter gelesen
+  CODE_FAILED,    // ausgefallen, nur noch Probes mit Backoff
+  CODE_TIMEOUT,   // Snapshot: kein Ergebnis bis zum Timeout
+};
+
+inline const char *sensorCodeName(uint8_t code) {
+  switch (code) {
+    case CODE_OK:      return "ok";
+    case CODE_SUSPECT: return "suspect";
+    case CODE_FAILED:  return "failed";
+    case CODE_TIMEOUT: return "timeout";
+    default:           return "missing";
+  }
+}
+
+// ----------------------------------------------------
+// Ein Messbild: Rohwerte der Result-Register + Status
+//
+// Gespeichert wird das 16-Bit-Register (Exponent/Mantisse),
+// nicht der Lux-Wert. Umrechnung erst beim Ausgeben.
+// Bit (row * NUM_SENSORS_PER_CHANNEL + col) in 'valid'
+// ist gesetzt, wenn der Wert gültig ist; 'code' sagt,
+// warum ein Wert fehlt.
+// ----------------------------------------------------
+struct LuxFrame {
+  uint32_t seq;         // Frame-Nummer, fortlaufend ab 1
+  uint32_t timestamp;   // millis() bei Veröffentlichung
+  uint32_t triggerUs;   // Snapshot: micros() des Triggers, sonst 0
+  uint32_t scanStartUs; // micros(): Beginn des Frame-Zeitraums (Snapshot: Trigger)
+  uint32_t scanEndUs;   // micros(): Werte eingesammelt
+  uint16_t raw[TOTAL_ROWS][NUM_SENSORS_PER_CHANNEL];
+  uint16_t ageMs[TOTAL_ROWS][NUM_SENSORS_PER_CHANNEL];  // Alter des Werts bei 'timestamp'
+  uint8_t  code[TOTAL_ROWS][NUM_SENSORS_PER_CHANNEL];   // SensorCode
+  uint64_t valid;
+
+  static uint8_t index(uint8_t row, uint8_t col) {
+    return row * NUM_SENSORS_PER_CHANNEL + col;
+  }
+
+  void clear() {
+    seq = 0;
+    timestamp = 0;
+    triggerUs = 0;
+    scanStartUs = 0;
+    scanEndUs = 0;
+    memset(raw, 0, sizeof(raw));
+    memset(ageMs, 0xFF, sizeof(ageMs));
+    memset(code, CODE_MISSING, sizeof(code));
+    valid = 0;
+  }
+
+  void set(uint8_t row, uint8_t col, uint16_t value) {
+    raw[row][col]  = value;
+    code[row][col] = CODE_OK;
+    valid |= (uint64_t)1 << index(row, col);
+  }
+
+  void invalidate(uint8_t row, uint8_t col, uint8_t why = CODE_MISSING) {
+    raw[row][col]  = 0;
+    code[row][col] = why;
+    valid &= ~((uint64_t)1 << index(row, col));
+  }
+
+  bool isValid(uint8_t row, uint8_t col) const {
+    return (valid >> index(row, col)) & 1;
+  }
+
+  float lux(uint8_t row, uint8_t col) const {
+    return opt3001::lux_from_raw(raw[row][col]);
+  }
+
+  // Vergleich der Messwerte auf Registerebene, ohne Float-Rechnung
+  // (ungültige Werte sind über invalidate() immer 0; seq, Zeitstempel
+  // und Alter zählen nicht)
+  bool operator==(const LuxFrame &o) const {
+    return valid == o.valid && memcmp(raw, o.raw, sizeof(raw)) == 0;
+  }
+  bool operator!=(const LuxFrame &o) const { return !(*this == o); }
+};
+
+#endif
@@ -0,0 +1,124 @@
+#ifndef MUX_BANK_H
+#define MUX_BANK_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <atomic>
+
+#include "topology.h"
+#include "bus_recovery.h"
+
+// ----------------------------------------------------
+// TCA9548-Muxe eines I2C-Busses mit Zustands-Cache
+//
+// Verwaltet nur die Muxe mit MUX_BUS == bus. Merkt sich
+// die Kanalmaske jedes Muxes und schreibt nur, wenn sich
+// die Maske ändert. select() garantiert, dass höchstens
+// ein Mux aktiv ist (gleiche Sensoradressen hinter allen
+// Muxen); nur openAll() öffnet bewusst alle für
+// Broadcast-Schreibzugriffe. verify() liest die Control-
+// Register zurück und erkennt verfälschte Zustände.
+//
+// Nach jedem Umschalten wird die Settle-Zeit des Kanals
+// abgewartet. Sie wird beim Boot je Kanal eingemessen
+// (Opt3001Array::calibrateSettle) und bei NACKs auf dem
+// Kanal per bumpSettle() schrittweise erhöht. Nach
+// MUX_SETTLE_DECAY_SELECTS fehlerfreien Umschaltungen
+// (settleOk()) wird sie wieder halbiert, höchstens bis auf
+// den eingemessenen Wert: ein einzelner Störer bremst den
+// Kanal also nicht dauerhaft.
+// ----------------------------------------------------
+#define MUX_MAX_CHANNELS      8
+#define MUX_SETTLE_DEFAULT_US 500    // bisheriger fester Wert
+#define MUX_SETTLE_MIN_BUMP   20
+#define MUX_SETTLE_MAX_US     2000
+#define MUX_SETTLE_DECAY_SELECTS 256
+
+// Schreibzugriff auf ein Control-Register (für gebündelte Transaktionen)
+struct MuxWrite {
+  uint8_t addr;
+  uint8_t mask;
+};
+
+class MuxBank {
+public:
+  void begin(TwoWire &wire, uint8_t bus);
+
+  // Mux hängt an diesem Bus
+  bool owns(uint8_t mux) const { return mux < NUM_MUXES && (m_member & (1 << mux)); }
+
+  // Genau einen Kanal eines Muxes aktivieren, alle anderen Muxe aus,
+  // bei Wechsel Settle-Zeit abwarten.
+  // Rückgabe: 1 = umgeschaltet, 0 = war schon so, <0 = I2C-Fehler
+  int select(uint8_t mux, uint8_t ch);
+
+  // Maske eines Muxes setzen, alle anderen Muxe aus
+  int selectMask(uint8_t mux, uint8_t mask);
+
+  // Alle Kanäle aller Muxe öffnen (nur für Broadcast-Schreiben)
+  int openAll();
+
+  // Alle Muxe abschalten
+  int disableAll();
+
+  // Für select() nötige Schreibzugriffe ermitteln, ohne den Bus
+  // anzufassen (Ausführung extern, z.B. per I2cBatch; ohne Settle-Zeit).
+  // Rückgabe: Anzahl Einträge in 'out'
+  uint8_t planSelect(uint8_t mux, uint8_t ch, MuxWrite out[NUM_MUXES]);
+  // Ergebnis eines extern ausgeführten planSelect() übernehmen
+  void applySelect(uint8_t mux, uint8_t ch, bool ok);
+
+  // Cache verwerfen (z.B. nach Bus-Reset), nächster Zugriff schreibt
+  void invalidate() { m_known = 0; }
+
+  // Nach Bus-Recovery: gecachte Masken neu schreiben (unbekannte: aus).
+  // Rückgabe: 0 = ok, <0 = I2C-Fehler
+  int restore();
+
+  // Seit dem letzten Aufruf trat ein Bus-Fehler (kein NACK) auf
+  bool takeBusFault() { bool f = m_busFault; m_busFault = false; return f; }
+
+  // Control-Register zurücklesen; Abweichungen werden korrigiert.
+  // Rückgabe: Anzahl verfälschter Muxe
+  uint8_t verify();
+
+  // --- Settle-Modell je Kanal ---
+  uint16_t settleUs(uint8_t mux, uint8_t ch) const { return m_settleUs[mux][ch]; }
+  // Eingemessener Wert, zugleich Untergrenze für settleOk()
+  void     setSettleUs(uint8_t mux, uint8_t ch, uint16_t us);
+  // NACK auf dem Kanal: Settle-Zeit verdoppeln (mind. +MUX_SETTLE_MIN_BUMP)
+  void     bumpSettle(uint8_t mux, uint8_t ch);
+  // Zugriff direkt nach Umschalten fehlerfrei: Richtung Untergrenze
+  void     settleOk(uint8_t mux, uint8_t ch);
+
+  uint32_t settleBumps()  const { return m_settleBumps.load(std::memory_order_relaxed); }
+  uint32_t settleDecays() const { return m_settleDecays.load(std::memory_order_relaxed); }
+  uint32_t writes()      const { return m_writes.load(std::memory_order_relaxed); }
+  uint32_t saved()       const { return m_saved.load(std::memory_order_relaxed); }
+  uint32_t corruptions() const { return m_corruptions.load(std::memory_order_relaxed); }
+
+private:
+  // Gecachter Schreibzugriff auf einen Mux
+  int setMask(uint8_t mux, uint8_t mask);
+  // Alle Muxe außer 'keep' abschalten
+  int disableOthers(uint8_t keep);
+  // Längste Settle-Zeit der Kanäle in 'mask' abwarten
+  void settle(uint8_t mux, uint8_t mask);
+
+  TwoWire *m_wire = NULL;
+  uint8_t  m_mask[NUM_MUXES];
+  uint8_t  m_member = 0;  // Bit m: Mux m hängt an diesem Bus
+  uint8_t  m_known = 0;   // Bit m: m_mask[m] entspricht der Hardware
+  bool     m_busFault = false;
+  uint16_t m_settleUs[NUM_MUXES][MUX_MAX_CHANNELS];
+  uint16_t m_settleFloorUs[NUM_MUXES][MUX_MAX_CHANNELS];   // eingemessen
+  uint16_t m_settleClean[NUM_MUXES][MUX_MAX_CHANNELS];     // fehlerfrei seit der letzten Änderung
+
+  std::atomic<uint32_t> m_writes{0};        // tatsächlich geschriebene Masken
+  std::atomic<uint32_t> m_saved{0};         // eingesparte Schreibzugriffe
+  std::atomic<uint32_t> m_corruptions{0};   // beim Zurücklesen abweichend
+  std::atomic<uint32_t> m_settleBumps{0};   // adaptive Erhöhungen
+  std::atomic<uint32_t> m_settleDecays{0};  // Halbierungen nach fehlerfreien Umschaltungen
+};
+
+#endif
@@ -0,0 +1,322 @@
+#ifndef OPT3001_ARRAY_H
+#define OPT3001_ARRAY_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <opt3001.h>
+
+#include "topology.h"
+#include "mux_bank.h"
+#include "i2c_batch.h"
+#include "bus_recovery.h"
+#include "sensor_map.h"
+
+// Kanäle per ESP-IDF Command-Link gebündelt lesen (0 = nur Wire).
+// Per Build-Flag überschreibbar: mit -D OPT3001_ARRAY_BATCHED=0
+// läuft jeder Zugriff über TwoWire (der Host-Simulator in test/sim
+// kann beide Pfade, siehe env:native).
+#ifndef OPT3001_ARRAY_BATCHED
+#define OPT3001_ARRAY_BATCHED 1
+#endif
+
+// ----------------------------------------------------
+// Zustand eines Sensors
+//
+// OK ──Fehler──▶ SUSPECT ──HEALTH_SUSPECT_LIMIT Fehler──▶ FAILED
+//  ▲                │ Erfolg                                 │ Backoff abgelaufen
+//  └────────────────┴──────────── Erfolg ◀── PROBING ◀───────┘
+//                                               │ Fehler: Backoff verdoppeln
+//                                               └──────────▶ FAILED
+//
+// Nur OK-Sensoren laufen im gebündelten Kanal-Zugriff mit,
+// alle anderen einzeln über Wire, damit ihr NACK die
+// Transaktion der gesunden Sensoren nicht kippt.
+// ----------------------------------------------------
+enum SensorHealth : uint8_t {
+  HEALTH_OK = 0,
+  HEALTH_SUSPECT,
+  HEALTH_FAILED,
+  HEALTH_PROBING,
+};
+
+#define HEALTH_SUSPECT_LIMIT  3       // Fehler in Folge bis FAILED
+#define HEALTH_BACKOFF_MIN_MS 250     // erster Probe-Abstand
+#define HEALTH_BACKOFF_MAX_MS 32000   // Obergrenze beim Verdoppeln
+
+// Fenster-Modus: Grenzen um den letzten Wert (relativ, mind. absolut)
+#define WINDOW_PERCENT       5
+#define WINDOW_MIN_CENTILUX  10      // 0.1 lx, damit Dunkelheit nicht flackert
+
+// Hot-Plug: Buszeit je Frame für das Abfragen leerer Plätze
+#define HOTPLUG_BUDGET_US 1000
+
+// Lage eines Sensors im Wandlungs-Raster (siehe Opt3001Array)
+enum GridPhase : uint8_t {
+  GRID_LOCKED = 0,   // Raster bekannt: nur das Result lesen
+  GRID_CLEAR,        // CRF vor der erwarteten Wandlung löschen
+  GRID_POLL,         // CRF je Aufruf abfragen, bis es gesetzt ist
+};
+
+// Fovea: ruhige Zeilen nur jede n-te Wandlung lesen
+#define FOVEA_COLD_CONVERSIONS 5
+#define FOVEA_MAX_STALE_MS     500     // Default für die Alters-Garantie
+
+// ----------------------------------------------------
+// Ein Eintrag pro physikalischem Sensor
+// ----------------------------------------------------
+struct Opt3001Slot {
+  opt3001  dev;       // Treiber, einmalig beim Boot gebunden
+  uint8_t  mux;       // Index in MUX_ADDR
+  uint8_t  channel;   // Mux-Kanal
+  uint8_t  addr;      // I2C-Adresse des Sensors
+  uint8_t  row;       // Zeile in der Lux-Matrix
+  uint8_t  col;       // Spalte in der Lux-Matrix
+  bool     mapped;    // laut Sensor-Karte bestückt
+  bool     present;   // beim Konfigurieren erkannt
+  bool     pending;   // Snapshot: Ergebnis des Triggers steht noch aus
+  int8_t   status;    // 0 = ok, sonst negativer Fehlercode
+  uint8_t  health;    // SensorHealth
+  uint8_t  failures;  // Fehler in Folge
+  uint16_t backoffMs; // FAILED: aktueller Probe-Abstand
+  bool     armed;     // Fenster-Modus: Limit-Register um 'raw' gesetzt
+  uint16_t raw;       // letzter Inhalt des Result-Registers
+  uint32_t sampleUs;  // micros() beim Lesen von 'raw'
+  uint32_t dueUs;     // nächster Zugriff (Result bzw. CRF)
+  // Wandlungs-Raster: Wandlung k endet bei anchorUs + k * periodUs
+  uint8_t  grid;      // GridPhase
+  bool     unread;    // CRF nach der gelesenen Wandlung gelöscht
+  uint32_t seen;      // zuletzt gelesene Wandlung (ab Anker)
+  uint32_t target;    // nächste zu lesende Wandlung
+  uint32_t anchorUs;  // Ende der Anker-Wandlung, frühestens ...
+  uint32_t resUs;     // ... anchorUs - resUs
+  uint32_t periodUs;  // gemessene Wandlungszeit
+  uint32_t slackUs;   // Unsicherheit von periodUs je Wandlung
+  uint32_t pollUs;    // Beginn der letzten CRF-Abfrage
+  uint32_t baseUs;    // Mitte der Basis-Wandlung für periodUs ...
+  uint32_t baseResUs; // ... und ihre Unsicherheit
+  uint32_t baseCount; // Wandlungen von der Basis bis zum Anker
+};
+
+// ----------------------------------------------------
+// Sensor-Array: Tabelle aller OPT3001 hinter den Muxen
+// eines I2C-Busses (ein Array je Bus)
+//
+// Die Tabelle wird beim Boot einmal aus MUX_ADDR /
+// MUX_CHANNEL_COUNT / SENSOR_ADDR aufgebaut und ist nach
+// (Mux, Kanal) sortiert. Welche Plätze bestückt sind, sagt
+// die Sensor-Karte (NVS bzw. Discovery, siehe sensor_map.h);
+// leere Plätze werden beim Konfigurieren nicht angesprochen.
+// service() läuft linear darüber und schaltet den Mux (über
+// MuxBank) nur beim Kanalwechsel um.
+//
+// Gelesen wird nach dem Wandlungs-Raster jedes Sensors:
+// aus einem Anker (CRF beim Setzen beobachtet) und der
+// gemessenen Wandlungszeit ist bekannt, wann Wandlung k
+// fertig ist, samt Fehlerschranke. Solange die Schranke
+// klein ist, wird der Sensor kurz nach dem Ende seiner
+// Wandlung fällig und nur das Result gelesen; der Pointer
+// bleibt dort stehen (Streaming-Modus des Treibers: reiner
+// 2-Byte-Read). Das CRF wird nur abgefragt, um das Raster
+// neu zu verankern: nach GRID_SPAN_MAX Wandlungen, wenn die
+// Schranke zu groß wird, ein Read in die Unschärfe um eine
+// Wandlung fällt oder nach Neustart, Fehler und Moduswechsel.
+// So wird jede Wandlung höchstens einmal gelesen.
+//
+// Das erste Register aller fälligen Sensoren eines Kanals
+// (Result bzw. Config) wird als eine I2cBatch-Transaktion
+// gelesen (nach der Mux-Auswahl, die mit ihrem eigenen STOP
+// abschließt), nötige Results nach der Config in einer
+// zweiten; der Wire-Pfad bleibt als Fallback.
+//
+// Scheitern Zugriffe und hängt dabei eine Leitung (oder
+// meldet Wire einen Bus-Fehler), setzt recoverBus() den Bus
+// zurück und stellt Mux-Zustände und Pointer wieder her.
+//
+// Fenster-Modus (nur Continuous): nach jedem gelesenen Wert
+// werden LIMITL/LIMITH auf ±WINDOW_PERCENT darum gesetzt.
+// Im Latched-Window-Betrieb (L = 1) halten FH/FL fest, ob
+// eine Wandlung seitdem das Fenster verlassen hat. Je
+// Wandlungszeit wird dann nur noch das Config-Register
+// gelesen (Pointer bleibt dort stehen: reiner 2-Byte-Read);
+// das Result nur bei gesetztem Flag. Ohne Flag gilt der
+// letzte Wert als bestätigt (Alter = Zeitpunkt der Prüfung).
+//
+// Zeilenplan (Fovea): Sensoren in "heißen" Zeilen werden
+// jede Wandlung gelesen, alle anderen nur jede n-te
+// (n = FOVEA_COLD_CONVERSIONS, begrenzt durch das maximale
+// Alter). Schneller als die Wandlungszeit geht nicht; der
+// Gewinn ist die Buszeit der ruhigen Zeilen.
+// ----------------------------------------------------
+class Opt3001Array {
+public:
+  // Tabelle für die Muxe eines Busses aufbauen, Treiber binden.
+  // Rückgabe: Anzahl Sensoren
+  uint8_t begin(TwoWire &wire, uint8_t bus);
+
+  // Sensor-Karte aus dem NVS laden, sonst Discovery + Speichern.
+  // Rückgabe: true, wenn die Karte aus dem NVS kam
+  bool loadMap();
+  // Nach configure(): alle laut Karte bestückten Sensoren erkannt?
+  bool mapConsistent() const;
+  // Bus neu vermessen, Karte speichern, Sensoren neu konfigurieren
+  // (auch für /rescan; nur vom Besitzer des Busses aufrufen)
+  void rescan();
+  const SensorMap &sensorMap() const { return m_map; }
+
+  // Leere Plätze reihum abfragen (höchstens budgetUs Buszeit), neu
+  // gefundene Sensoren konfigurieren und in den Scan aufnehmen.
+  // Ausgefallene Sensoren deckt die Health-Probe ab.
+  // Rückgabe: Anzahl neu aufgenommener Sensoren
+  uint8_t probeEmpty(uint32_t budgetUs);
+  uint32_t hotplugged() const { return m_hotplugged.load(std::memory_order_relaxed); }
+
+  // Alle Sensoren auf Default-Konfiguration zurücksetzen (Broadcast)
+  void reset();
+
+  // Alle Sensoren per Broadcast konfigurieren (Continuous Mode) und
+  // erkennen; verify = Config je Sensor zurücklesen und vergleichen
+  void configure(enum opt3001_conversion_time ct, bool verify = true);
+
+  // Minimale zuverlässige Mux-Settle-Zeit je Kanal einmessen
+  // (nach configure(), nutzt erkannte Sensoren als Gegenstelle)
+  void calibrateSettle();
+
+  // Ein Register aller Sensoren aller Muxe des Busses schreiben (je Mux alle
+  // Kanäle aktiv). Rückgabe: Anzahl quittierter Transaktionen
+  uint8_t broadcastWrite(enum opt3001_register reg, uint16_t value);
+
+  // Fällige Sensoren abfragen, neue Wandlungen lesen
+  void service(uint32_t nowUs);
+
+  // --- Snapshot-Modus (global synchrone Single-Shot-Frames) ---
+  void setSnapshotMode(bool snapshot);
+  bool snapshotMode() const { return m_snapshot; }
+  // Alle Sensoren gleichzeitig starten, Rückgabe: micros() des Triggers
+  uint32_t triggerSnapshot();
+  // true, wenn alle getriggerten Sensoren gelesen wurden
+  bool snapshotComplete() const;
+  // Ausstehende Sensoren als Timeout markieren
+  void abortSnapshot();
+  uint32_t conversionUs() const { return m_conversionUs; }
+
+  // --- Zeilenplan ---
+  // Bit r in hotRows: Zeile r jede Wandlung lesen; übrige Zeilen
+  // seltener, aber nie älter als maxStaleMs (+ ein Abfrage-Tick)
+  void setRowSchedule(uint32_t hotRows, uint16_t maxStaleMs);
+  // Bereich, in dem maxStaleMs wirkt: eine bis FOVEA_COLD_CONVERSIONS
+  // Wandlungszeiten (darüber gilt die Obergrenze)
+  uint16_t minStaleMs() const { return m_conversionUs / 1000; }
+  uint16_t maxStaleLimitMs() const { return FOVEA_COLD_CONVERSIONS * (m_conversionUs / 1000); }
+
+  // --- Fenster-Modus (nur Änderungen lesen) ---
+  void setWindowMode(bool window);
+  bool windowMode() const { return m_window; }
+  uint32_t windowChecks() const { return m_windowChecks.load(std::memory_order_relaxed); }
+  uint32_t windowReads()  const { return m_windowReads.load(std::memory_order_relaxed); }
+
+  uint8_t size() const { return m_count; }
+  const Opt3001Slot &slot(uint8_t i) const { return m_slots[i]; }
+
+  // Alter des letzten Messwerts in ms (0xFFFF = kein gültiger Wert)
+  uint16_t sampleAgeMs(const Opt3001Slot &s, uint32_t nowUs) const;
+
+  // Bus-Recovery durchführen, danach Muxe und Register-Pointer
+  // wiederherstellen. Rückgabe: 0 = Bus frei
+  int recoverBus();
+  const BusRecovery &recovery() const { return m_recovery; }
+
+  // Gebündeltes Lesen ein-/ausschalten (aus = Sensor für Sensor über Wire)
+  void setBatched(bool batched) { m_batched = batched; }
+  bool batched() const { return m_batched; }
+
+  MuxBank &mux() { return m_mux; }
+  const MuxBank &mux() const { return m_mux; }
+
+private:
+  // Mux auf den Kanal des Sensors schalten (nur bei Wechsel).
+  // Rückgabe: true, wenn tatsächlich umgeschaltet wurde
+  bool route(const Opt3001Slot &s);
+
+  bool isDue(const Opt3001Slot &s, uint32_t nowUs) const;
+  // Health-Übergänge nach einem Zugriff
+  void markOk(Opt3001Slot &s);
+  void markFailed(Opt3001Slot &s, int8_t err, uint32_t nowUs);
+  // FAILED-Sensor einmal ansprechen, Config ggf. wiederherstellen
+  void probe(Opt3001Slot &s, uint32_t nowUs);
+
+  // Wandlungen bis zum nächsten Lesen laut Zeilenplan
+  uint32_t rowConversions(const Opt3001Slot &s) const {
+    return (m_hotRows >> s.row) & 1 ? 1 : m_coldConversions;
+  }
+
+  // --- Wandlungs-Raster ---
+  // Vorhergesagtes Ende von Wandlung k und seine Fehlerschranke
+  uint32_t gridEdgeUs(const Opt3001Slot &s, uint32_t k) const { return s.anchorUs + k * s.periodUs; }
+  uint32_t gridSlackUs(const Opt3001Slot &s, uint32_t k) const;
+  // Wandlungen, die bis tUs sicher bzw. möglicherweise fertig sind
+  uint32_t gridDone(const Opt3001Slot &s, uint32_t tUs) const;
+  uint32_t gridMaybe(const Opt3001Slot &s, uint32_t tUs) const;
+  // Nur das Result lesen (Raster gilt, kein Fenster/Snapshot)?
+  bool gridLocked(const Opt3001Slot &s) const {
+    return s.grid == GRID_LOCKED && !m_snapshot && !windowed(s);
+  }
+  // Neu starten: Wandlung 0 endete in (startUs - resUs, startUs]
+  void gridRestart(Opt3001Slot &s, uint32_t startUs, uint32_t resUs);
+  // Wandlung k als nächste lesen (bzw. vorher das CRF abfragen)
+  void gridSchedule(Opt3001Slot &s, uint32_t k);
+  // Result im Raster gelesen (Zugriff zwischen t0Us und t1Us)
+  void gridResult(Opt3001Slot &s, uint16_t raw, uint32_t t0Us, uint32_t t1Us);
+  // Config im Raster gelesen. Rückgabe: true = Result jetzt lesen
+  bool gridConfig(Opt3001Slot &s, uint16_t config, uint32_t t0Us, uint32_t t1Us);
+  // Neuen Wert übernehmen
+  void sampled(Opt3001Slot &s, uint16_t raw, uint32_t sampleUs);
+
+  // Muxe, Kanäle und Adressen 0x44..0x47 abfragen
+  void discover(SensorMap &map);
+  void applyMap();
+
+  // Einen leeren Platz prüfen und ggf. aufnehmen
+  bool adopt(Opt3001Slot &s);
+  // Settle-Zeit des Kanals von 's' einmessen und setzen
+  uint16_t calibrateChannel(Opt3001Slot &s);
+
+  // Sensor wird nur über die Fenster-Flags überwacht
+  bool windowed(const Opt3001Slot &s) const { return m_window && !m_snapshot && s.armed; }
+  // Limit-Register um den aktuellen Wert setzen
+  void arm(Opt3001Slot &s);
+  // Gelesene Config auswerten, bei verlassenem Fenster Result lesen
+  void windowCheck(Opt3001Slot &s, uint16_t config, uint32_t nowUs);
+  // Ein Sensor über Wire (Result bzw. CRF, dann ggf. Result)
+  void serviceSlot(Opt3001Slot &s, uint32_t nowUs);
+  // Fällige Sensoren m_slots[first..end) eines Kanals gebündelt
+  // (Result bzw. Config, dann nötige Results). Rückgabe: 0 = erledigt,
+  // <0 = Wire-Pfad nötig
+  int serviceBatch(uint8_t first, uint8_t end, uint32_t nowUs);
+
+  TwoWire    *m_wire = NULL;
+  uint8_t     m_bus  = 0;
+  SensorMap   m_map;
+  MuxBank     m_mux;
+  I2cBatch    m_batch;
+  BusRecovery m_recovery;
+  Opt3001Slot m_slots[TOTAL_SENSORS];
+  uint8_t     m_count = 0;
+
+  enum opt3001_conversion_time m_ct = OPT3001_CONVERSION_TIME_100MS;
+  uint32_t    m_conversionUs = 100000;   // Wandlungszeit laut Konfiguration
+  bool        m_snapshot     = false;
+  bool        m_batched      = OPT3001_ARRAY_BATCHED;
+  uint8_t     m_passErrors   = 0;   // fehlgeschlagene Zugriffe im laufenden service()
+  bool        m_window       = false;
+  uint32_t    m_hotRows      = 0xFFFFFFFF;   // alle Zeilen volle Rate
+  uint16_t    m_maxStaleMs   = FOVEA_MAX_STALE_MS;
+  uint8_t     m_coldConversions = 1;
+
+  uint8_t     m_probeNext = 0;   // Hot-Plug: nächster Platz
+
+  std::atomic<uint32_t> m_hotplugged{0};     // zur Laufzeit aufgenommene Sensoren
+  std::atomic<uint32_t> m_windowChecks{0};   // nur Flags gelesen
+  std::atomic<uint32_t> m_windowReads{0};    // davon Fenster verlassen → Result gelesen
+};
+
+#endif
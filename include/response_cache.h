@@ -0,0 +1,60 @@
+#ifndef RESPONSE_CACHE_H
+#define RESPONSE_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ----------------------------------------------------
+// Fertig serialisierte Antworten je Frame
+//
+// Alles, was nur vom Frame abhängt (/data, /age, /times,
+// /data.bin), wird je Format höchstens einmal pro Frame
+// erzeugt; jeder weitere Client bekommt dieselben Bytes. Schlüssel ist
+// LuxFrame::seq des Frames, aus dem die Antwort entstand:
+// der Handler liest zuerst den aktuellen Frame und fragt
+// dann mit dessen seq nach. Nach einer Veröffentlichung
+// passt die seq nicht mehr und der Eintrag wird beim
+// nächsten Zugriff neu geschrieben; ein Client sieht also
+// nie Bytes eines älteren Frames als den, den er gelesen hat.
+//
+// Nur aus dem loop-Task (WebServer) benutzen.
+// ----------------------------------------------------
+#define RESPONSE_CACHE_ENTRY_SIZE 1536   // /data: 60 × max. "83865.6," bzw. "\"timeout\","
+
+enum ResponseFormat : uint8_t {
+  RESPONSE_DATA_JSON = 0,
+  RESPONSE_AGE_JSON,
+  RESPONSE_TIMES_JSON,
+  RESPONSE_DATA_BIN,
+  RESPONSE_FORMAT_COUNT
+};
+
+struct CachedResponse {
+  uint32_t seq;
+  uint16_t length;
+  bool     valid;
+  char     data[RESPONSE_CACHE_ENTRY_SIZE];
+};
+
+class ResponseCache {
+public:
+  // Antwort zu 'seq' oder NULL (Fehltreffer); zählt Treffer/Fehltreffer
+  const CachedResponse *find(uint8_t format, uint32_t seq);
+
+  // Puffer des Formats zum Neuschreiben; der Eintrag ist bis
+  // commit() ungültig
+  char *begin(uint8_t format);
+
+  // Geschriebene Antwort unter 'seq' ablegen
+  const CachedResponse *commit(uint8_t format, uint32_t seq, size_t length);
+
+  uint32_t hits() const { return m_hits; }
+  uint32_t misses() const { return m_misses; }
+
+private:
+  CachedResponse m_entries[RESPONSE_FORMAT_COUNT] = {};
+  uint32_t       m_hits   = 0;
+  uint32_t       m_misses = 0;
+};
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef SENSOR_MAP_H
+#define SENSOR_MAP_H
+
+#include <Arduino.h>
+
+#include "topology.h"
+#include "mux_bank.h"
+
+// ----------------------------------------------------
+// Beim Boot ermittelte Bestückung eines I2C-Busses
+//
+// Je Mux-Kanal ein Bitfeld der antwortenden OPT3001-
+// Adressen 0x44..0x47 (MANUID/DEVIID geprüft), dazu welche
+// TCA9548-Adressen 0x70..0x77 quittiert haben. Die Karte
+// liegt je Bus im NVS (Preferences) und trägt einen Hash
+// über Inhalt und die Topologie-Konstanten der Firmware:
+// ändert sich topology.h, ist die gespeicherte Karte
+// automatisch ungültig.
+// ----------------------------------------------------
+#define SENSOR_MAP_VERSION   1
+#define SENSOR_MAP_NAMESPACE "topology"
+#define SENSOR_MAP_ADDR_BASE 0x44   // OPT3001: 0x44..0x47
+#define SENSOR_MAP_ADDR_NUM  4
+#define SENSOR_MAP_MUX_BASE  0x70   // TCA9548: 0x70..0x77
+
+struct SensorMap {
+  uint8_t  version;
+  uint8_t  muxAck;                                     // Bit i: 0x70 + i quittiert
+  uint8_t  addrMask[NUM_MUXES][MUX_MAX_CHANNELS];      // Bit a: OPT3001 an 0x44 + a
+  uint32_t hash;
+
+  void clear();
+  uint32_t computeHash() const;
+  void seal() { version = SENSOR_MAP_VERSION; hash = computeHash(); }
+  bool valid() const { return version == SENSOR_MAP_VERSION && hash == computeHash(); }
+
+  bool has(uint8_t mux, uint8_t ch, uint8_t addr) const {
+    if (addr < SENSOR_MAP_ADDR_BASE || addr >= SENSOR_MAP_ADDR_BASE + SENSOR_MAP_ADDR_NUM) return false;
+    return (addrMask[mux][ch] >> (addr - SENSOR_MAP_ADDR_BASE)) & 1;
+  }
+
+  // NVS, ein Schlüssel je Bus. load() liefert nur gültige Karten
+  bool load(uint8_t bus);
+  bool store(uint8_t bus) const;
+};
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef TOPOLOGY_H
+#define TOPOLOGY_H
+
+#include <stdint.h>
+
+// ----------------------------------------------------
+// Sensor- / Mux-Konfiguration
+// ----------------------------------------------------
+const uint8_t NUM_MUXES = 3;
+const uint8_t MUX_ADDR[NUM_MUXES]          = { 0x70, 0x71, 0x72 };
+const uint8_t MUX_CHANNEL_COUNT[NUM_MUXES] = { 8,    8,    4    };
+
+const uint8_t NUM_SENSORS_PER_CHANNEL = 3;
+const uint8_t SENSOR_ADDR[NUM_SENSORS_PER_CHANNEL] = { 0x44, 0x45, 0x46 };
+
+#define TOTAL_ROWS 20   // 0 .. 19
+
+// ----------------------------------------------------
+// I2C-Busse: Zuordnung Mux → Controller (0 = Wire, 1 = Wire1)
+// Busse mit eigenen Muxen werden parallel gescannt.
+// Zeilen zählen unabhängig vom Bus in Mux-Reihenfolge.
+// ----------------------------------------------------
+const uint8_t NUM_I2C_BUSES = 2;
+const uint8_t MUX_BUS[NUM_MUXES] = { 0, 0, 0 };
+
+#define I2C0_SDA SDA    // Wire, Board-Default aus pins_arduino.h
+#define I2C0_SCL SCL
+#define I2C1_SDA 32     // Wire1, an Verdrahtung anpassen
+#define I2C1_SCL 33
+#define I2C_FREQ_HZ 100000
+
+inline bool busUsed(uint8_t bus) {
+  for (uint8_t m = 0; m < NUM_MUXES; m++) {
+    if (MUX_BUS[m] == bus) return true;
+  }
+  return false;
+}
+
+// Obergrenze für die Sensortabelle (eine Zeile je Mux-Kanal)
+const uint8_t TOTAL_SENSORS = TOTAL_ROWS * NUM_SENSORS_PER_CHANNEL;
+
+#endif
@@ -1,6 +1,16 @@
 /* Self header */
 #include "opt3001.h"
 
+/**
+ * Lux per mantissa LSB for each exponent value (0.01 * 2^exponent).
+ * Scaling by a power of two commutes with rounding to float, so each entry
+ * equals the float nearest to the exact scale.
+ */
+static constexpr float OPT3001_LUX_SCALE[16] = {
+    0.01f, 0.02f, 0.04f, 0.08f, 0.16f, 0.32f, 0.64f, 1.28f,
+    2.56f, 5.12f, 10.24f, 20.48f, 40.96f, 81.92f, 163.84f, 327.68f,
+};
+
 /**
  * Reads the contents of the given register.
  * @param[in] reg_address The address of the register.
@@ -15,24 +25,35 @@ int opt3001::register_read(const enum opt3001_register reg_address, uint16_t *co
         return -EINVAL;
     }
 
-    /* Send register address */
-    m_i2c_library->beginTransmission(m_i2c_address);
-    m_i2c_library->write(reg_address);
-    res = m_i2c_library->endTransmission(false);
-    if (res != 0) {
-        return -EIO;
+    /* Send register address, unless in streaming mode and the pointer already targets it */
+    if (!m_result_streaming || !m_register_pointer_valid || m_register_pointer != reg_address) {
+        m_i2c_library->beginTransmission(m_i2c_address);
+        m_i2c_library->write(reg_address);
+        res = m_i2c_library->endTransmission(false);
+        if (res != 0) {
+            m_register_pointer_valid = false;
+            return -EIO;
+        }
+        m_register_pointer = reg_address;
+        m_register_pointer_valid = true;
     }
 
     /* Read data */
     m_i2c_library->requestFrom(m_i2c_address, (uint8_t)2, (uint8_t)true);
     res = m_i2c_library->available();
     if (res == 0) {
+        m_register_pointer_valid = false;
         return -EIO;
     }
     *reg_content = m_i2c_library->read();
     *reg_content <<= 8;
     *reg_content |= m_i2c_library->read();
 
+    /* Reading the configuration refreshes its shadow copy for free */
+    if (reg_address == OPT3001_REGISTER_CONFIG) {
+        config_shadow_update(*reg_content, false);
+    }
+
     /* Return success */
     return 0;
 }
@@ -58,9 +79,20 @@ int opt3001::register_write(const enum opt3001_register reg_address, const uint1
     m_i2c_library->write((uint8_t)(reg_content >> 0));
     res = m_i2c_library->endTransmission(true);
     if (res != 0) {
+        m_register_pointer_valid = false;
+        if (reg_address == OPT3001_REGISTER_CONFIG) m_config_shadow_valid = false;
         return -EIO;
     }
 
+    /* Track configuration writes in the shadow copy */
+    if (reg_address == OPT3001_REGISTER_CONFIG) {
+        config_shadow_update(reg_content, true);
+    }
+
+    /* A write leaves the register pointer on the written register */
+    m_register_pointer = reg_address;
+    m_register_pointer_valid = true;
+
     /* Return success */
     return 0;
 }
@@ -87,6 +119,10 @@ int opt3001::setup(TwoWire &i2c_library, const uint8_t i2c_address) {
     m_i2c_address = i2c_address;
     m_i2c_library = &i2c_library;
 
+    /* Pointer and configuration of the (possibly different) device are unknown */
+    m_register_pointer_valid = false;
+    m_config_shadow_valid = false;
+
     /* Return success */
     return 0;
 }
@@ -144,14 +180,11 @@ int opt3001::config_set(const enum opt3001_conversion_time ct) {
 
     /* Enable automatic full scale
      * Set conversion time */
-    uint16_t reg_config;
-    res = register_read(OPT3001_REGISTER_CONFIG, &reg_config);
+    opt3001_config config;
+    res = config_read(&config);
     if (res < 0) return -EIO;
-    reg_config &= ~(0b1111 << 12);
-    reg_config |= 0b1100 << 12;
-    reg_config &= ~(0b1 << 11);
-    reg_config |= (ct == OPT3001_CONVERSION_TIME_800MS) ? 0b1 : 0b0;
-    res = register_write(OPT3001_REGISTER_CONFIG, reg_config);
+    config.range_set(OPT3001_RANGE_AUTO).conversion_time_set(ct);
+    res = config_write(config);
     if (res < 0) return -EIO;
 
     /* Return success */
@@ -172,12 +205,11 @@ int opt3001::conversion_continuous_enable(void) {
     int res;
 
     /* Set continuous conversion mode */
-    uint16_t reg_config;
-    res = register_read(OPT3001_REGISTER_CONFIG, &reg_config);
+    opt3001_config config;
+    res = config_read(&config);
     if (res < 0) return -EIO;
-    reg_config &= ~(0b11 << 9);
-    reg_config |= (0b11 << 9);
-    res = register_write(OPT3001_REGISTER_CONFIG, reg_config);
+    config.mode_set(OPT3001_MODE_CONTINUOUS);
+    res = config_write(config);
     if (res < 0) return -EIO;
 
     /* Return success */
@@ -198,12 +230,11 @@ int opt3001::conversion_continuous_disable(void) {
     int res;
 
     /* Set shutdown conversion mode */
-    uint16_t reg_config;
-    res = register_read(OPT3001_REGISTER_CONFIG, &reg_config);
+    opt3001_config config;
+    res = config_read(&config);
     if (res < 0) return -EIO;
-    reg_config &= ~(0b11 << 9);
-    reg_config |= (0b00 << 9);
-    res = register_write(OPT3001_REGISTER_CONFIG, reg_config);
+    config.mode_set(OPT3001_MODE_SHUTDOWN);
+    res = config_write(config);
     if (res < 0) return -EIO;
 
     /* Return success */
@@ -225,13 +256,38 @@ int opt3001::conversion_singleshot_trigger(void) {
     int res;
 
     /* Set single-shot conversion mode */
+    opt3001_config config;
+    res = config_read(&config);
+    if (res < 0) return -EIO;
+    config.mode_set(OPT3001_MODE_SINGLESHOT);
+    res = config_write(config);
+    if (res < 0) return -EIO;
+
+    /* Return success */
+    return 0;
+}
+
+/**
+ * Check whether a new conversion result is available
+ *
+ * Reads the configuration register and returns the conversion ready flag
+ * (CRF, bit 7). The flag is set when a conversion completes and the result
+ * register has been updated, and is cleared by the sensor when the
+ * configuration register is read or written. Polling this function therefore
+ * reports every completed conversion exactly once, which allows reading the
+ * result register only when it holds a new value.
+ *
+ * @param[out] ready Pointer to variable that will receive the flag
+ * @return 0 on success, -EIO on I2C communication failure
+ */
+int opt3001::conversion_ready_read(bool *const ready) {
+    int res;
+
+    /* Read conversion ready flag */
     uint16_t reg_config;
     res = register_read(OPT3001_REGISTER_CONFIG, &reg_config);
     if (res < 0) return -EIO;
-    reg_config &= ~(0b11 << 9);
-    reg_config |= (0b01 << 9);
-    res = register_write(OPT3001_REGISTER_CONFIG, reg_config);
-    if (res < 0) return -EIO;
+    *ready = conversion_ready_from_config(reg_config);
 
     /* Return success */
     return 0;
@@ -265,14 +321,383 @@ int opt3001::lux_read(float *const lux) {
     }
 
     /* Convert to float */
-#if 0
-    *lux = (float)(reg_result);
-#else
+    *lux = lux_from_raw(reg_result);
+
+    /* Return success */
+    return 0;
+}
+
+/**
+ * Convert a raw result register value to centi-lux
+ *
+ * The result register holds a 12-bit mantissa (bits 0-11) and a 4-bit
+ * exponent (bits 12-15), with lux = 0.01 * mantissa * 2^exponent. Scaled by
+ * 100 this is an exact integer shift; the largest value (4095 << 15) fits in
+ * 27 bits.
+ *
+ * @param[in] reg_result Content of the result register
+ * @return Illuminance in units of 0.01 lux
+ */
+uint32_t opt3001::centilux_from_raw(const uint16_t reg_result) {
+    uint32_t mantissa = reg_result & 0x0FFF;
+    uint8_t exponent = (reg_result & 0xF000) >> 12;
+    return mantissa << exponent;
+}
+
+/**
+ * Convert a raw result register value to lux
+ *
+ * Replaces the double-precision pow() of the original conversion with a
+ * lookup of the per-exponent scale and one single-precision product. Since
+ * the table entries are rounded, the product alone can be off by one ulp;
+ * one fused multiply-add correction step (residual of x / 100) makes the
+ * result the correctly rounded quotient, which is bit-exact with
+ * mantissa * (0.01 * pow(2, exponent)) for all 65536 register values.
+ *
+ * @param[in] reg_result Content of the result register
+ * @return Illuminance in lux
+ */
+float opt3001::lux_from_raw(const uint16_t reg_result) {
     uint16_t mantissa = reg_result & 0x0FFF;
-    uint16_t exponent = (reg_result & 0xF000) >> 12;
-    *lux = mantissa * (0.01 * pow(2, exponent));
-#endif
+    uint8_t exponent = (reg_result & 0xF000) >> 12;
+
+    /* Exact numerator: mantissa * 2^exponent fits the 24-bit float significand */
+    float centilux = (float)(mantissa << exponent);
+
+    /* Approximate quotient, then correct with the exact residual */
+    float lux = (float)mantissa * OPT3001_LUX_SCALE[exponent];
+    float residual = fmaf(-lux, 100.0f, centilux);
+    return fmaf(residual, 0.01f, lux);
+}
+
+/**
+ * Enable streaming result mode
+ *
+ * Sets the register pointer of the sensor to the result register and keeps
+ * track of it. The OPT3001 retains its register pointer between transactions,
+ * so as long as no other register is accessed, every following lux_read()
+ * only needs the 2-byte read transaction instead of a pointer write, a
+ * repeated start and the read. This roughly halves the bus time per sample.
+ *
+ * Accesses to the configuration, limit or ID registers through this driver
+ * move the tracked pointer, and the next result read writes it again, so
+ * callers never read the wrong register.
+ *
+ * @return 0 on success, -EINVAL if not initialized, -EIO on I2C communication
+ *         failure
+ */
+int opt3001::result_streaming_enable(void) {
+    int res;
+
+    /* Ensure library has been configured */
+    if (m_i2c_library == NULL) {
+        return -EINVAL;
+    }
+
+    /* Point the sensor at the result register */
+    m_i2c_library->beginTransmission(m_i2c_address);
+    m_i2c_library->write(OPT3001_REGISTER_RESULT);
+    res = m_i2c_library->endTransmission(true);
+    if (res != 0) {
+        m_register_pointer_valid = false;
+        return -EIO;
+    }
+    m_register_pointer = OPT3001_REGISTER_RESULT;
+    m_register_pointer_valid = true;
+    m_result_streaming = true;
 
     /* Return success */
     return 0;
 }
+
+/**
+ * Disable streaming result mode
+ *
+ * Returns to the default behaviour where every register read first writes
+ * the register pointer.
+ */
+void opt3001::result_streaming_disable(void) {
+    m_result_streaming = false;
+}
+
+/**
+ * Forget the tracked register pointer
+ *
+ * The driver can only track pointer changes it performs itself. Call this
+ * after the sensor was written without this instance (raw bus access,
+ * broadcast writes through a multiplexer) or may have lost power, so that the
+ * next read writes the register pointer again.
+ */
+void opt3001::register_pointer_invalidate(void) {
+    m_register_pointer_valid = false;
+}
+
+/**
+ * Check whether a register read needs a register pointer write first
+ *
+ * Lets callers that drive the bus themselves (for example a batched
+ * transaction combining several sensors behind a multiplexer) apply the same
+ * pointer tracking as register_read(): in streaming mode the pointer write is
+ * skipped when the tracked pointer already targets the register.
+ *
+ * @param[in] reg_address Register address to read from
+ * @return true if the pointer must be written before the 2-byte read
+ */
+bool opt3001::register_read_pointer_required(const enum opt3001_register reg_address) const {
+    return !m_result_streaming || !m_register_pointer_valid || m_register_pointer != reg_address;
+}
+
+/**
+ * Complete a register read that was executed outside this driver instance
+ *
+ * Whether or not the pointer was written as part of the external transaction,
+ * after a successful read it targets reg_address, which is what the driver
+ * tracks from now on.
+ *
+ * @param[in] reg_address Register address that was read
+ * @param[in] data The two bytes returned by the sensor, most significant byte first
+ * @param[out] reg_content Pointer to variable that will receive the register value
+ * @return 0 on success
+ */
+int opt3001::register_read_complete(const enum opt3001_register reg_address, const uint8_t data[2], uint16_t *const reg_content) {
+
+    /* Decode big-endian register content */
+    *reg_content = data[0];
+    *reg_content <<= 8;
+    *reg_content |= data[1];
+
+    /* Reading the configuration refreshes its shadow copy */
+    if (reg_address == OPT3001_REGISTER_CONFIG) {
+        config_shadow_update(*reg_content, false);
+    }
+
+    /* Pointer now targets the register that was read */
+    m_register_pointer = reg_address;
+    m_register_pointer_valid = true;
+
+    /* Return success */
+    return 0;
+}
+
+/**
+ * Extract the conversion ready flag from a configuration register value
+ *
+ * CRF is bit 7 of the configuration register. Useful when the register was
+ * read through register_read() or an external transaction; reading the
+ * register clears the flag in the sensor either way.
+ *
+ * @param[in] reg_config Content of the configuration register
+ * @return true if a new conversion result is available
+ */
+bool opt3001::conversion_ready_from_config(const uint16_t reg_config) {
+    return (reg_config & (0b1 << 7)) != 0;
+}
+
+/**
+ * Program the low and high limit registers for window comparison
+ *
+ * The limit registers use the same exponent and mantissa format as the
+ * result register. The low limit is rounded down and the high limit rounded
+ * up, so the programmed window always contains the requested one.
+ *
+ * @param[in] low_centilux Low limit in units of 0.01 lux
+ * @param[in] high_centilux High limit in units of 0.01 lux
+ * @return 0 on success, -EIO on I2C communication failure
+ */
+int opt3001::limits_set(const uint32_t low_centilux, const uint32_t high_centilux) {
+    int res;
+
+    /* Write both limits */
+    res = register_write(OPT3001_REGISTER_LIMITL, limit_from_centilux(low_centilux, false));
+    if (res < 0) return -EIO;
+    res = register_write(OPT3001_REGISTER_LIMITH, limit_from_centilux(high_centilux, true));
+    if (res < 0) return -EIO;
+
+    /* Return success */
+    return 0;
+}
+
+/**
+ * Encode an illuminance in centi-lux into the limit register format
+ *
+ * Inverse of centilux_from_raw() for the limit registers: exponents above 11
+ * are not valid there, so values beyond 4095 << 11 saturate at 0xBFFF.
+ *
+ * @param[in] centilux Illuminance in units of 0.01 lux
+ * @param[in] round_up Round up instead of down when low bits are lost
+ * @return Limit register content
+ */
+uint16_t opt3001::limit_from_centilux(const uint32_t centilux, const bool round_up) {
+    for (uint8_t exponent = 0; exponent <= 11; exponent++) {
+        uint32_t mantissa = centilux >> exponent;
+        if (round_up && (centilux & ((1UL << exponent) - 1))) mantissa++;
+        if (mantissa <= 0x0FFF) {
+            return (exponent << 12) | mantissa;
+        }
+    }
+    return 0xBFFF;
+}
+
+/**
+ * Check a configuration register value for the window comparison flags
+ *
+ * FH is bit 6 and FL bit 5 of the configuration register.
+ *
+ * @param[in] reg_config Content of the configuration register
+ * @return true if either flag is set
+ */
+bool opt3001::limit_exceeded_from_config(const uint16_t reg_config) {
+    return (reg_config & (0b11 << 5)) != 0;
+}
+
+/**
+ * Create a configuration builder
+ *
+ * Only the writable fields are kept; read-only flags in reg_config are
+ * dropped.
+ *
+ * @param[in] reg_config Initial configuration register value
+ */
+opt3001_config::opt3001_config(const uint16_t reg_config) : m_word(reg_config & WRITABLE) {
+}
+
+/**
+ * Set the full-scale range (RN, bits 15:12)
+ * @param[in] range Manual range or OPT3001_RANGE_AUTO
+ * @return Reference to this builder
+ */
+opt3001_config &opt3001_config::range_set(const enum opt3001_range range) {
+    m_word = (m_word & ~(0b1111 << 12)) | ((uint16_t)range << 12);
+    return *this;
+}
+
+/**
+ * Set the conversion time (CT, bit 11)
+ * @param[in] ct Conversion time setting
+ * @return Reference to this builder
+ */
+opt3001_config &opt3001_config::conversion_time_set(const enum opt3001_conversion_time ct) {
+    m_word = (m_word & ~(0b1 << 11)) | ((ct == OPT3001_CONVERSION_TIME_800MS ? 0b1 : 0b0) << 11);
+    return *this;
+}
+
+/**
+ * Set the mode of conversion operation (M, bits 10:9)
+ * @param[in] mode Shutdown, single-shot or continuous
+ * @return Reference to this builder
+ */
+opt3001_config &opt3001_config::mode_set(const enum opt3001_mode mode) {
+    m_word = (m_word & ~(0b11 << 9)) | ((uint16_t)mode << 9);
+    return *this;
+}
+
+/**
+ * Set the latch field (L, bit 4)
+ * @param[in] latched true for latched window-style comparison
+ * @return Reference to this builder
+ */
+opt3001_config &opt3001_config::latch_set(const bool latched) {
+    m_word = (m_word & ~(0b1 << 4)) | ((latched ? 0b1 : 0b0) << 4);
+    return *this;
+}
+
+/**
+ * Set the INT pin polarity (POL, bit 3)
+ * @param[in] active_high true for active high
+ * @return Reference to this builder
+ */
+opt3001_config &opt3001_config::polarity_set(const bool active_high) {
+    m_word = (m_word & ~(0b1 << 3)) | ((active_high ? 0b1 : 0b0) << 3);
+    return *this;
+}
+
+/**
+ * Set the fault count (FC, bits 1:0)
+ * @param[in] fc Number of consecutive faults that set the flags
+ * @return Reference to this builder
+ */
+opt3001_config &opt3001_config::fault_count_set(const enum opt3001_fault_count fc) {
+    m_word = (m_word & ~0b11) | (uint16_t)fc;
+    return *this;
+}
+
+/**
+ * Get the composed configuration register value
+ * @return Configuration register value (writable fields only)
+ */
+uint16_t opt3001_config::word(void) const {
+    return m_word;
+}
+
+/**
+ * Write a complete configuration in a single transaction
+ *
+ * Replaces the read-modify-write sequences of the individual setters: all
+ * fields are composed on the host and written at once.
+ *
+ * @param[in] config Configuration composed with opt3001_config
+ * @return 0 on success, -EIO on I2C communication failure
+ */
+int opt3001::config_write(const opt3001_config &config) {
+    int res;
+
+    /* Write configuration (updates the shadow copy) */
+    res = register_write(OPT3001_REGISTER_CONFIG, config.word());
+    if (res < 0) return -EIO;
+
+    /* Return success */
+    return 0;
+}
+
+/**
+ * Get the current configuration
+ *
+ * The driver keeps a shadow copy of the writable configuration fields,
+ * updated on every configuration read and write it performs. The sensor is
+ * only read when the shadow is unknown, i.e. after setup(), a failed write
+ * or config_shadow_invalidate().
+ *
+ * @param[out] config Pointer to builder that will receive the configuration
+ * @return 0 on success, -EIO on I2C communication failure
+ */
+int opt3001::config_read(opt3001_config *const config) {
+    int res;
+
+    /* Read from the sensor only if the shadow is unknown */
+    if (!m_config_shadow_valid) {
+        uint16_t reg_config;
+        res = register_read(OPT3001_REGISTER_CONFIG, &reg_config);
+        if (res < 0) return -EIO;
+    }
+    *config = opt3001_config(m_config_shadow);
+
+    /* Return success */
+    return 0;
+}
+
+/**
+ * Forget the shadow copy of the configuration register
+ *
+ * The next config_read() reads the register from the sensor.
+ */
+void opt3001::config_shadow_invalidate(void) {
+    m_config_shadow_valid = false;
+}
+
+/**
+ * Update the shadow copy of the configuration register
+ *
+ * A single-shot conversion returns the sensor to shutdown on its own, so a
+ * written single-shot mode is recorded as shutdown: that is the state the
+ * register settles in and the base for the next read-modify-write.
+ *
+ * @param[in] reg_config Configuration register value read or written
+ * @param[in] written true if the value was written by the driver
+ */
+void opt3001::config_shadow_update(const uint16_t reg_config, const bool written) {
+    m_config_shadow = reg_config & opt3001_config::WRITABLE;
+    if (written && ((m_config_shadow >> 9) & 0b11) == OPT3001_MODE_SINGLESHOT) {
+        m_config_shadow &= ~(0b11 << 9);
+    }
+    m_config_shadow_valid = true;
+}
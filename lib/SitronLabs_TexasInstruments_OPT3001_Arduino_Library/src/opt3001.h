@@ -29,6 +29,90 @@ enum opt3001_conversion_time {
     OPT3001_CONVERSION_TIME_800MS,  ///< 800ms conversion time
 };
 
+/**
+ * OPT3001 full-scale range (RN field of the configuration register)
+ */
+enum opt3001_range {
+    OPT3001_RANGE_40LUX = 0,     ///< 40.95 lux full scale
+    OPT3001_RANGE_81LUX = 1,     ///< 81.90 lux full scale
+    OPT3001_RANGE_163LUX = 2,    ///< 163.80 lux full scale
+    OPT3001_RANGE_327LUX = 3,    ///< 327.60 lux full scale
+    OPT3001_RANGE_655LUX = 4,    ///< 655.20 lux full scale
+    OPT3001_RANGE_1310LUX = 5,   ///< 1310.40 lux full scale
+    OPT3001_RANGE_2620LUX = 6,   ///< 2620.80 lux full scale
+    OPT3001_RANGE_5241LUX = 7,   ///< 5241.60 lux full scale
+    OPT3001_RANGE_10483LUX = 8,  ///< 10483.20 lux full scale
+    OPT3001_RANGE_20966LUX = 9,  ///< 20966.40 lux full scale
+    OPT3001_RANGE_41932LUX = 10, ///< 41932.80 lux full scale
+    OPT3001_RANGE_83865LUX = 11, ///< 83865.60 lux full scale
+    OPT3001_RANGE_AUTO = 12,     ///< Automatic full-scale setting
+};
+
+/**
+ * OPT3001 mode of conversion operation (M field of the configuration register)
+ */
+enum opt3001_mode {
+    OPT3001_MODE_SHUTDOWN = 0b00,    ///< Shutdown (low power)
+    OPT3001_MODE_SINGLESHOT = 0b01,  ///< One conversion, then shutdown
+    OPT3001_MODE_CONTINUOUS = 0b11,  ///< Continuous conversions
+};
+
+/**
+ * OPT3001 fault count (FC field of the configuration register)
+ */
+enum opt3001_fault_count {
+    OPT3001_FAULT_COUNT_1 = 0b00,  ///< One fault sets the flags
+    OPT3001_FAULT_COUNT_2 = 0b01,  ///< Two consecutive faults
+    OPT3001_FAULT_COUNT_4 = 0b10,  ///< Four consecutive faults
+    OPT3001_FAULT_COUNT_8 = 0b11,  ///< Eight consecutive faults
+};
+
+/**
+ * OPT3001 configuration register builder
+ *
+ * Holds the writable fields of the configuration register. Setters can be chained to
+ * compose a complete configuration, which opt3001::config_write() then writes in a single
+ * transaction. Read-only flags (OVF, CRF, FH, FL) are never part of the word.
+ */
+class opt3001_config {
+   public:
+    /**
+     * Create a builder from a configuration register value
+     * @param[in] reg_config Initial register value, defaults to the power-on reset value 0xC810
+     */
+    opt3001_config(const uint16_t reg_config = 0xC810);
+
+    opt3001_config &range_set(const enum opt3001_range range);
+    opt3001_config &conversion_time_set(const enum opt3001_conversion_time ct);
+    opt3001_config &mode_set(const enum opt3001_mode mode);
+
+    /**
+     * Select the interrupt reporting mechanism
+     * @param[in] latched true for latched window-style comparison, false for transparent hysteresis-style
+     */
+    opt3001_config &latch_set(const bool latched);
+
+    /**
+     * Select the INT pin polarity
+     * @param[in] active_high true for active high, false for active low (reset default)
+     */
+    opt3001_config &polarity_set(const bool active_high);
+
+    opt3001_config &fault_count_set(const enum opt3001_fault_count fc);
+
+    /**
+     * Get the composed register value (writable fields only)
+     * @return Configuration register value
+     */
+    uint16_t word(void) const;
+
+    /** Mask of the writable configuration register bits */
+    static const uint16_t WRITABLE = 0xFE1F;
+
+   protected:
+    uint16_t m_word;
+};
+
 /**
  * OPT3001 ambient light sensor driver class
  *
@@ -60,6 +144,29 @@ class opt3001 {
      */
     int config_set(const enum opt3001_conversion_time ct);
 
+    /**
+     * Write a complete configuration in a single transaction
+     * Updates the shadow copy of the configuration register.
+     * @param[in] config Configuration composed with opt3001_config
+     * @return 0 on success, negative error code on I2C communication failure
+     */
+    int config_write(const opt3001_config &config);
+
+    /**
+     * Get the current configuration
+     * Served from the shadow copy when it is known, otherwise read from the sensor.
+     * @param[out] config Pointer to builder that will receive the configuration
+     * @return 0 on success, negative error code on I2C communication failure
+     */
+    int config_read(opt3001_config *const config);
+
+    /**
+     * Forget the shadow copy of the configuration register
+     * Must be called when the configuration was written without this driver instance (raw bus
+     * writes, broadcast writes through a multiplexer) or the sensor may have been power-cycled.
+     */
+    void config_shadow_invalidate(void);
+
     /**
      * Enable continuous conversion mode
      * The sensor will continuously perform conversions and update the result register
@@ -81,6 +188,15 @@ class opt3001 {
      */
     int conversion_singleshot_trigger(void);
 
+    /**
+     * Check whether a new conversion result is available
+     * Reads the conversion ready flag (CRF) of the configuration register. The sensor
+     * clears the flag on this read, so each completed conversion is reported once.
+     * @param[out] ready Pointer to variable that will receive the flag
+     * @return 0 on success, negative error code on I2C communication failure
+     */
+    int conversion_ready_read(bool *const ready);
+
     /**
      * Read a 16-bit register from the OPT3001 sensor
      * @param[in] reg_address Register address to read from
@@ -106,9 +222,109 @@ class opt3001 {
      */
     int lux_read(float *const lux);
 
+    /**
+     * Convert a raw result register value to centi-lux
+     * Exact integer form of the datasheet formula: lux * 100 = mantissa << exponent
+     * @param[in] reg_result Content of the result register
+     * @return Illuminance in units of 0.01 lux
+     */
+    static uint32_t centilux_from_raw(const uint16_t reg_result);
+
+    /**
+     * Convert a raw result register value to lux
+     * Single-precision path without pow(), bit-exact with mantissa * (0.01 * 2^exponent)
+     * evaluated in double precision and rounded to float
+     * @param[in] reg_result Content of the result register
+     * @return Illuminance in lux
+     */
+    static float lux_from_raw(const uint16_t reg_result);
+
+    /**
+     * Enable streaming result mode
+     * Points the sensor at the result register once. Subsequent reads of a register the
+     * pointer already targets (typically lux_read) skip the pointer write and only issue
+     * the 2-byte read. Any access to another register moves the tracked pointer.
+     * @return 0 on success, negative error code on I2C communication failure
+     */
+    int result_streaming_enable(void);
+
+    /**
+     * Disable streaming result mode
+     * Every register read writes the register pointer again (default behaviour).
+     */
+    void result_streaming_disable(void);
+
+    /**
+     * Forget the tracked register pointer
+     * Must be called when the sensor was accessed without this driver instance (raw bus
+     * writes, broadcast writes through a multiplexer) or may have been power-cycled.
+     */
+    void register_pointer_invalidate(void);
+
+    /**
+     * Check whether a register read needs a register pointer write first
+     * For reads executed outside this driver instance, e.g. queued into a batched bus
+     * transaction. Follows the same rules as register_read().
+     * @param[in] reg_address Register address to read from
+     * @return true if the pointer must be written before the 2-byte read
+     */
+    bool register_read_pointer_required(const enum opt3001_register reg_address) const;
+
+    /**
+     * Complete a register read that was executed outside this driver instance
+     * Decodes the two data bytes and records the register pointer as set to reg_address.
+     * On a failed transaction call register_pointer_invalidate() instead.
+     * @param[in] reg_address Register address that was read
+     * @param[in] data The two bytes returned by the sensor, most significant byte first
+     * @param[out] reg_content Pointer to variable that will receive the register value
+     * @return 0 on success
+     */
+    int register_read_complete(const enum opt3001_register reg_address, const uint8_t data[2], uint16_t *const reg_content);
+
+    /**
+     * Extract the conversion ready flag from a configuration register value
+     * @param[in] reg_config Content of the configuration register
+     * @return true if a new conversion result is available
+     */
+    static bool conversion_ready_from_config(const uint16_t reg_config);
+
+    /**
+     * Program the low and high limit registers for window comparison
+     * With latched window-style comparison (L = 1) the sensor sets the FL/FH flags when a
+     * conversion falls outside the window; they stay set until the configuration register
+     * is read.
+     * @param[in] low_centilux Low limit in units of 0.01 lux (rounded down)
+     * @param[in] high_centilux High limit in units of 0.01 lux (rounded up)
+     * @return 0 on success, negative error code on I2C communication failure
+     */
+    int limits_set(const uint32_t low_centilux, const uint32_t high_centilux);
+
+    /**
+     * Encode an illuminance in centi-lux into the limit register format
+     * Uses the smallest exponent (0 to 11) whose 12-bit mantissa can hold the value.
+     * @param[in] centilux Illuminance in units of 0.01 lux
+     * @param[in] round_up Round up instead of down when low bits are lost
+     * @return Limit register content, saturated at the largest limit
+     */
+    static uint16_t limit_from_centilux(const uint32_t centilux, const bool round_up);
+
+    /**
+     * Check a configuration register value for the window comparison flags
+     * @param[in] reg_config Content of the configuration register
+     * @return true if the high (FH) or low (FL) flag is set
+     */
+    static bool limit_exceeded_from_config(const uint16_t reg_config);
+
    protected:
     TwoWire *m_i2c_library = NULL;
     uint8_t m_i2c_address;
+    bool m_result_streaming = false;
+    bool m_register_pointer_valid = false;
+    enum opt3001_register m_register_pointer = OPT3001_REGISTER_RESULT;
+    bool m_config_shadow_valid = false;
+    uint16_t m_config_shadow;
+
+    void config_shadow_update(const uint16_t reg_config, const bool written);
 };
 
 #endif
@@ -0,0 +1,296 @@
+#include "acquisition.h"
+
+// Befehle Koordinator → Worker (Task-Notification-Bits)
+#define CMD_CAPTURE (1 << 0)   // eigene Zeilen in Worker::stage eintragen
+#define CMD_TRIGGER (1 << 1)   // Snapshot auslösen und einsammeln
+#define CMD_RESCAN  (1 << 2)   // Topologie neu vermessen (Erfassung angehalten)
+
+// ----------------------------------------------------
+// Tasks starten
+// ----------------------------------------------------
+bool Acquisition::begin(Opt3001Array *const arrays[], uint8_t count) {
+  if (count > NUM_I2C_BUSES) count = NUM_I2C_BUSES;
+  m_numWorkers = 0;
+  m_lastScanEndUs = micros();
+
+  // Worker zuerst: sie reagieren nur auf Befehle des Koordinators
+  for (uint8_t i = 0; i < count; i++) {
+    Worker &w   = m_workers[m_numWorkers];
+    w.acq       = this;
+    w.array     = arrays[i];
+    w.task      = NULL;
+    w.busyUs    = 0;
+    w.triggerUs = 0;
+    w.owned     = 0;
+    w.scanUs    = 0;
+    w.lastOwned = 0;
+    w.stage.clear();
+    if (xTaskCreatePinnedToCore(workerEntry, "acq-bus", ACQ_TASK_STACK, &w,
+                                ACQ_TASK_PRIO, &w.task, ACQ_TASK_CORE) != pdPASS) {
+      return false;
+    }
+    m_numWorkers++;
+  }
+
+  return xTaskCreatePinnedToCore(coordinatorEntry, "acq", ACQ_TASK_STACK, this,
+                                 ACQ_TASK_PRIO, &m_coordinator, ACQ_TASK_CORE) == pdPASS;
+}
+
+// ----------------------------------------------------
+// Alters-Garantie der ruhigen Zeilen (Fovea)
+// ----------------------------------------------------
+// setRowSchedule() liest ruhige Zeilen höchstens jede
+// FOVEA_COLD_CONVERSIONS-te Wandlung; größere Werte würden
+// stillschweigend gekappt, also gleich hier begrenzen.
+uint16_t Acquisition::setMaxStaleMs(uint16_t ms) {
+  for (uint8_t i = 0; i < m_numWorkers; i++) {
+    const Opt3001Array &a = *m_workers[i].array;
+    if (ms > a.maxStaleLimitMs()) ms = a.maxStaleLimitMs();
+    if (ms < a.minStaleMs()) ms = a.minStaleMs();
+  }
+  m_maxStaleMs.store(ms, std::memory_order_relaxed);
+  return ms;
+}
+
+void Acquisition::coordinatorEntry(void *arg) {
+  static_cast<Acquisition *>(arg)->runCoordinator();
+}
+
+void Acquisition::workerEntry(void *arg) {
+  Worker *w = static_cast<Worker *>(arg);
+  w->acq->runWorker(*w);
+}
+
+// ----------------------------------------------------
+// Koordinator: Frame-Raster bzw. Snapshot-Zyklus
+// ----------------------------------------------------
+void Acquisition::runCoordinator() {
+  const TickType_t period = pdMS_TO_TICKS(FRAME_PERIOD_MS);
+  TickType_t wake = xTaskGetTickCount();
+  uint32_t rescans = m_rescans.load(std::memory_order_relaxed);
+
+  for (;;) {
+    // Rescan nur zwischen zwei Frames: kein CAPTURE/TRIGGER ist offen,
+    // bis alle Worker fertig sind (oder der Timeout greift)
+    uint32_t wantRescans = m_rescans.load(std::memory_order_relaxed);
+    if (wantRescans != rescans) {
+      rescans = wantRescans;
+      command(CMD_RESCAN, &Worker::rescanned, pdMS_TO_TICKS(RESCAN_TIMEOUT_MS));
+      wake = xTaskGetTickCount();   // Pause zählt nicht als verworfen
+    }
+
+    bool snapshot = m_wantSnapshot.load(std::memory_order_relaxed);
+    m_snapshotMode.store(snapshot, std::memory_order_relaxed);
+
+    if (snapshot) {
+      // Alle Busse gleichzeitig triggern, warten bis alle eingesammelt haben
+      uint32_t timeoutMs = 4 * FRAME_PERIOD_MS;
+      command(CMD_TRIGGER, &Worker::triggered, pdMS_TO_TICKS(timeoutMs));
+
+      // Frühester Trigger der Busse, die quittiert haben
+      uint32_t cmd = m_command.load(std::memory_order_relaxed);
+      uint32_t triggerUs = 0;
+      bool first = true;
+      for (uint8_t i = 0; i < m_numWorkers; i++) {
+        const Worker &w = m_workers[i];
+        if (w.triggered.load(std::memory_order_acquire) != cmd) continue;
+        if (first || (int32_t)(w.triggerUs - triggerUs) < 0) triggerUs = w.triggerUs;
+        first = false;
+      }
+
+      LuxFrame &f = m_frames.beginWrite();
+      publishFrame(f, triggerUs);
+      wake = xTaskGetTickCount();
+      continue;
+    }
+
+    // Continuous: nächster freier Slot, übersprungene zählen als verworfen
+    TickType_t next = wake + period;
+    TickType_t now  = xTaskGetTickCount();
+    while ((int32_t)(now - next) >= 0) {
+      next += period;
+      m_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    vTaskDelayUntil(&wake, next - wake);
+
+    LuxFrame &f = m_frames.beginWrite();
+    publishFrame(f, 0);
+  }
+}
+
+// ----------------------------------------------------
+// Frame zusammenführen und veröffentlichen
+// ----------------------------------------------------
+void Acquisition::publishFrame(LuxFrame &f, uint32_t triggerUs) {
+  f.clear();
+  f.seq = ++m_seq;
+
+  command(CMD_CAPTURE, &Worker::captured, pdMS_TO_TICKS(FRAME_PERIOD_MS));
+  uint32_t cmd = m_command.load(std::memory_order_relaxed);
+
+  // Zeitraum der Werte: seit dem letzten Einsammeln bzw. ab dem Trigger
+  f.scanEndUs   = micros();
+  f.scanStartUs = m_snapshotMode.load(std::memory_order_relaxed) ? triggerUs : m_lastScanEndUs;
+  m_lastScanEndUs = f.scanEndUs;
+
+  // Staging-Zeilen übernehmen. Nur von Workern mit passender
+  // Quittung: sie fassen 'stage' bis zum nächsten Befehl nicht
+  // mehr an. Verspätete Busse erscheinen als CODE_TIMEOUT.
+  uint32_t busy = 0;
+  for (uint8_t i = 0; i < m_numWorkers; i++) {
+    Worker &w = m_workers[i];
+    bool acked = w.captured.load(std::memory_order_acquire) == cmd;
+    if (acked) w.lastOwned = w.owned;
+
+    for (uint8_t p = 0; p < TOTAL_SENSORS; p++) {
+      if (!((w.lastOwned >> p) & 1)) continue;
+      uint8_t row = p / NUM_SENSORS_PER_CHANNEL;
+      uint8_t col = p % NUM_SENSORS_PER_CHANNEL;
+      if (!acked) {
+        f.code[row][col] = CODE_TIMEOUT;
+        continue;
+      }
+      f.code[row][col] = w.stage.code[row][col];
+      if (!w.stage.isValid(row, col)) continue;
+      f.raw[row][col]   = w.stage.raw[row][col];
+      f.ageMs[row][col] = w.stage.ageMs[row][col];
+    }
+    if (!acked) continue;
+
+    f.valid |= w.stage.valid;
+    if (w.scanUs > busy) busy = w.scanUs;
+  }
+  m_scanUs.store(busy, std::memory_order_relaxed);
+
+  f.timestamp = millis();
+  f.triggerUs = triggerUs;
+
+  m_activity.update(f);
+  m_hotRows.store(m_activity.hotRows(), std::memory_order_relaxed);
+
+  m_frames.publish();
+}
+
+// Notifications an den Koordinator wecken nur; ob ein Worker
+// fertig ist, sagt allein seine Quittung mit der Befehlsnummer
+// (verspätete Quittungen älterer Befehle zählen so nie mit)
+bool Acquisition::command(uint32_t cmd, std::atomic<uint32_t> Worker::*ack, TickType_t timeout) {
+  uint32_t seq = m_command.load(std::memory_order_relaxed) + 1;
+  m_command.store(seq, std::memory_order_release);
+
+  ulTaskNotifyTake(pdTRUE, 0);
+  for (uint8_t i = 0; i < m_numWorkers; i++) {
+    xTaskNotify(m_workers[i].task, cmd, eSetBits);
+  }
+
+  TickType_t start = xTaskGetTickCount();
+  for (;;) {
+    uint8_t done = 0;
+    for (uint8_t i = 0; i < m_numWorkers; i++) {
+      done += (m_workers[i].*ack).load(std::memory_order_acquire) == seq;
+    }
+    if (done == m_numWorkers) return true;
+
+    TickType_t waited = xTaskGetTickCount() - start;
+    if (waited >= timeout) return false;
+    ulTaskNotifyTake(pdTRUE, timeout - waited);
+  }
+}
+
+// Zustand eines Sensors für die Ausgabe
+static uint8_t slotCode(const Opt3001Slot &s) {
+  if (!s.present)                                              return CODE_MISSING;
+  if (s.health == HEALTH_FAILED || s.health == HEALTH_PROBING) return CODE_FAILED;
+  if (s.status == -ETIMEDOUT)                                  return CODE_TIMEOUT;
+  if (s.status != 0)                                           return CODE_SUSPECT;
+  return CODE_OK;
+}
+
+// ----------------------------------------------------
+// Worker: ein Bus, ein Sensor-Array
+// ----------------------------------------------------
+void Acquisition::runWorker(Worker &w) {
+  const TickType_t tick = pdMS_TO_TICKS(SCHED_TICK_MS);
+  Opt3001Array &a = *w.array;
+  bool collecting = false;   // Snapshot: Trigger offen, Quittung steht aus
+  uint32_t trigger = 0;      // Befehlsnummer des offenen Triggers
+  uint32_t captures = 0;
+
+  for (;;) {
+    // Wartet höchstens einen Tick, Befehle wecken sofort
+    uint32_t cmd = 0;
+    xTaskNotifyWait(0, 0xFFFFFFFF, &cmd, tick);
+
+    bool snapshot = m_snapshotMode.load(std::memory_order_relaxed);
+    if (snapshot != a.snapshotMode()) {
+      a.setSnapshotMode(snapshot);
+      collecting = false;
+    }
+    if (cmd & CMD_RESCAN) {
+      uint32_t seq = m_command.load(std::memory_order_acquire);
+      a.rescan();
+      collecting = false;
+      w.rescanned.store(seq, std::memory_order_release);
+      xTaskNotifyGive(m_coordinator);
+      continue;
+    }
+    a.setWindowMode(m_window.load(std::memory_order_relaxed));
+    a.setRowSchedule(m_fovea.load(std::memory_order_relaxed) ? m_hotRows.load(std::memory_order_relaxed)
+                                                             : 0xFFFFFFFF,
+                     m_maxStaleMs.load(std::memory_order_relaxed));
+
+    uint32_t t0 = micros();
+    if (cmd & CMD_TRIGGER) {
+      trigger     = m_command.load(std::memory_order_acquire);
+      w.triggerUs = a.triggerSnapshot();
+      collecting  = true;
+    }
+    a.service(t0);
+    w.busyUs += micros() - t0;
+
+    if (collecting) {
+      bool timeout = (micros() - w.triggerUs) > 2 * a.conversionUs();
+      if (a.snapshotComplete() || timeout) {
+        if (timeout) a.abortSnapshot();
+        collecting = false;
+        w.triggered.store(trigger, std::memory_order_release);
+        xTaskNotifyGive(m_coordinator);
+      }
+    }
+
+    if (cmd & CMD_CAPTURE) {
+      // Ein verspätet abgearbeitetes CAPTURE kann schon die Nummer des
+      // nächsten Befehls sehen; dann gilt der Eintrag eben für diesen.
+      // Bereits quittiert: 'stage' gehört dem Koordinator, nicht anfassen
+      uint32_t seq = m_command.load(std::memory_order_acquire);
+      if (w.captured.load(std::memory_order_relaxed) == seq) continue;
+
+      // Nur die eigenen Zeilen, in die eigenen Staging-Zeilen
+      LuxFrame &f    = w.stage;
+      uint32_t nowUs = micros();
+      f.valid = 0;
+      w.owned = 0;
+      for (uint8_t i = 0; i < a.size(); i++) {
+        const Opt3001Slot &s = a.slot(i);
+        uint64_t bit = (uint64_t)1 << LuxFrame::index(s.row, s.col);
+        w.owned |= bit;
+        f.code[s.row][s.col] = slotCode(s);
+        if (s.status != 0) continue;
+        f.raw[s.row][s.col]   = s.raw;
+        f.ageMs[s.row][s.col] = a.sampleAgeMs(s, nowUs);
+        f.valid |= bit;
+      }
+      w.scanUs = w.busyUs;
+
+      // Gelegentlich prüfen, ob die Muxe noch den gecachten Zustand haben
+      if (++captures % MUX_VERIFY_FRAMES == 0) a.mux().verify();
+
+      w.captured.store(seq, std::memory_order_release);
+      xTaskNotifyGive(m_coordinator);
+      w.busyUs = 0;
+
+      // Nach der Quittung: leere Plätze mit begrenzter Buszeit abfragen
+      a.probeEmpty(HOTPLUG_BUDGET_US);
+    }
+  }
+}
@@ -0,0 +1,36 @@
+#include "activity_map.h"
+
+void ActivityMap::update(const LuxFrame &f) {
+  const uint32_t hot = (uint32_t)ACTIVITY_HOT_PERMILLE * ACTIVITY_HOT_PERMILLE;
+  uint32_t rows = 0;
+
+  for (uint8_t r = 0; r < TOTAL_ROWS; r++) {
+    uint32_t change = 0;   // größte relative Änderung der Zeile in Promille
+
+    for (uint8_t c = 0; c < NUM_SENSORS_PER_CHANNEL; c++) {
+      if (!f.isValid(r, c)) continue;
+      uint32_t now = opt3001::centilux_from_raw(f.raw[r][c]);
+
+      if (m_prevValid & ((uint64_t)1 << LuxFrame::index(r, c))) {
+        uint32_t prev = m_prev[r][c];
+        uint32_t diff = now > prev ? now - prev : prev - now;
+        uint32_t ref  = prev > ACTIVITY_FLOOR_CENTILUX ? prev : ACTIVITY_FLOOR_CENTILUX;
+        uint32_t pm   = (uint64_t)diff * 1000 / ref;
+        if (pm > 1000) pm = 1000;
+        if (pm > change) change = pm;
+      }
+      m_prev[r][c] = now;
+    }
+
+    // EWMA von change²; Integer-Rundung lässt ruhige Zeilen auf 0 abklingen
+    int32_t delta = (int32_t)(change * change) - (int32_t)m_activity[r];
+    m_activity[r] += delta >> ACTIVITY_EWMA_SHIFT;
+
+    if (m_activity[r] >= hot) rows |= 1UL << r;
+  }
+  m_prevValid = f.valid;
+
+  // Nachbarzeilen mitnehmen
+  const uint32_t all = (TOTAL_ROWS >= 32) ? 0xFFFFFFFF : ((1UL << TOTAL_ROWS) - 1);
+  m_hotRows = (rows | (rows << 1) | (rows >> 1)) & all;
+}
@@ -0,0 +1,68 @@
+#include "bus_recovery.h"
+
+void BusRecovery::begin(TwoWire &wire, int sda, int scl, uint32_t freq) {
+  m_wire = &wire;
+  m_sda  = sda;
+  m_scl  = scl;
+  m_freq = freq;
+}
+
+// ----------------------------------------------------
+// Leitungen abtasten
+// ----------------------------------------------------
+// Die Pins bleiben dabei beim I2C-Treiber (Open-Drain mit
+// Eingang), gelesen wird nur der Pegel. Mehrere Proben,
+// damit ein gerade laufendes Clock-Stretching oder eine
+// Flanke nicht als Hänger zählt.
+bool BusRecovery::linesIdle() const {
+  if (m_sda < 0 || m_scl < 0) return true;
+  for (uint8_t i = 0; i < BUS_IDLE_SAMPLES; i++) {
+    if (digitalRead(m_sda) == HIGH && digitalRead(m_scl) == HIGH) return true;
+    delayMicroseconds(BUS_RECOVERY_HALF_US);
+  }
+  return false;
+}
+
+// ----------------------------------------------------
+// Recovery-Sequenz
+// ----------------------------------------------------
+int BusRecovery::recover() {
+  if (m_wire == NULL || m_sda < 0 || m_scl < 0) return -EINVAL;
+  m_recoveries.fetch_add(1, std::memory_order_relaxed);
+
+  // Pins vom Treiber übernehmen
+  m_wire->end();
+  pinMode(m_sda, INPUT_PULLUP);
+  pinMode(m_scl, OUTPUT_OPEN_DRAIN);
+  digitalWrite(m_scl, HIGH);
+  delayMicroseconds(BUS_RECOVERY_HALF_US);
+
+  // Bis zu neun Takte, bis der Slave SDA freigibt
+  for (uint8_t i = 0; i < BUS_RECOVERY_CLOCKS && digitalRead(m_sda) == LOW; i++) {
+    digitalWrite(m_scl, LOW);
+    delayMicroseconds(BUS_RECOVERY_HALF_US);
+    digitalWrite(m_scl, HIGH);
+    delayMicroseconds(BUS_RECOVERY_HALF_US);
+  }
+
+  // STOP: SDA low → high, während SCL high ist
+  digitalWrite(m_scl, LOW);
+  pinMode(m_sda, OUTPUT_OPEN_DRAIN);
+  digitalWrite(m_sda, LOW);
+  delayMicroseconds(BUS_RECOVERY_HALF_US);
+  digitalWrite(m_scl, HIGH);
+  delayMicroseconds(BUS_RECOVERY_HALF_US);
+  digitalWrite(m_sda, HIGH);
+  delayMicroseconds(BUS_RECOVERY_HALF_US);
+
+  bool idle = digitalRead(m_sda) == HIGH && digitalRead(m_scl) == HIGH;
+
+  // Treiber neu starten (setzt auch den I2C-Controller zurück)
+  m_wire->begin(m_sda, m_scl, m_freq);
+
+  if (!idle) {
+    m_failures.fetch_add(1, std::memory_order_relaxed);
+    return -EBUSY;
+  }
+  return 0;
+}
@@ -0,0 +1,199 @@
+#include "event_stream.h"
+
+#include <errno.h>
+#include <lwip/sockets.h>
+
+static const char SSE_HEADER[] =
+  "HTTP/1.1 200 OK\r\n"
+  "Content-Type: text/event-stream\r\n"
+  "Cache-Control: no-cache\r\n"
+  "Connection: keep-alive\r\n"
+  "Access-Control-Allow-Origin: *\r\n"
+  "\r\n"
+  "retry: 2000\n\n";   // Wiederverbinden des Browsers nach 2 s
+
+static const char SSE_NOT_FOUND[] =
+  "HTTP/1.1 404 Not Found\r\n"
+  "Content-Length: 0\r\n"
+  "Connection: close\r\n"
+  "\r\n";
+
+static const char SSE_BUSY[] =
+  "HTTP/1.1 503 Service Unavailable\r\n"
+  "Content-Type: application/json\r\n"
+  "Access-Control-Allow-Origin: *\r\n"
+  "Content-Length: 32\r\n"
+  "Connection: close\r\n"
+  "\r\n"
+  "{\"error\":\"too many subscribers\"}";
+
+static const char SSE_PATH[] = "GET /events";   // danach ' ' oder '?'
+
+static const char BASE64[] =
+  "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// Base64 nach 'out' (Platz für 4 * ceil(len / 3) Zeichen)
+static size_t base64Encode(const uint8_t *data, size_t len, char *out) {
+  size_t n = 0;
+  for (size_t i = 0; i < len; i += 3) {
+    uint32_t v = (uint32_t)data[i] << 16;
+    if (i + 1 < len) v |= (uint32_t)data[i + 1] << 8;
+    if (i + 2 < len) v |= data[i + 2];
+    out[n++] = BASE64[(v >> 18) & 0x3F];
+    out[n++] = BASE64[(v >> 12) & 0x3F];
+    out[n++] = (i + 1 < len) ? BASE64[(v >> 6) & 0x3F] : '=';
+    out[n++] = (i + 2 < len) ? BASE64[v & 0x3F] : '=';
+  }
+  return n;
+}
+
+// Kurze Antwort ohne Warten (passt in jeden Sendepuffer), dann trennen
+static void reject(WiFiClient &client, const char *text, size_t len) {
+  send(client.fd(), text, len, MSG_DONTWAIT);
+  client.stop();
+}
+
+// ----------------------------------------------------
+// Clients
+// ----------------------------------------------------
+void EventStream::begin() {
+  m_server.begin();
+  m_server.setNoDelay(true);
+}
+
+void EventStream::accept() {
+  for (;;) {
+    WiFiClient client = m_server.available();
+    if (!client) return;
+    if (!add(client)) reject(client, SSE_BUSY, sizeof(SSE_BUSY) - 1);
+  }
+}
+
+bool EventStream::add(const WiFiClient &client) {
+  for (uint8_t i = 0; i < SSE_MAX_CLIENTS; i++) {
+    Client &c = m_clients[i];
+    if (c.used) continue;
+
+    c.used    = true;
+    c.request = true;
+    c.client  = client;
+    c.client.setNoDelay(true);
+    c.sinceMs = millis();
+    c.parsed  = 0;
+    c.eol     = 0;
+    c.outLength = 0;
+    c.outOffset = 0;
+    return true;
+  }
+  return false;
+}
+
+uint8_t EventStream::clients() const {
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < SSE_MAX_CLIENTS; i++) n += m_clients[i].used;
+  return n;
+}
+
+// ----------------------------------------------------
+// Ereignis rendern und einreihen
+// ----------------------------------------------------
+bool EventStream::publish(uint32_t seq, const uint8_t *data, size_t len) {
+  char prefix[40];
+  int n = snprintf(prefix, sizeof(prefix), "id: %lu\nevent: frame\ndata: ", (unsigned long)seq);
+  if (n + 4 * ((len + 2) / 3) + 2 > SSE_EVENT_MAX) return false;
+
+  Event &e = m_events[m_head % SSE_QUEUE_DEPTH];
+  memcpy(e.text, prefix, n);
+  size_t length = n + base64Encode(data, len, e.text + n);
+  e.text[length++] = '\n';
+  e.text[length++] = '\n';
+  e.length = length;
+  m_head++;
+
+  // Drop-Oldest: keine Lesestelle darf hinter dem Ring liegen
+  for (uint8_t i = 0; i < SSE_MAX_CLIENTS; i++) {
+    Client &c = m_clients[i];
+    if (!c.used || m_head - c.next <= SSE_QUEUE_DEPTH) continue;
+    m_dropped += m_head - SSE_QUEUE_DEPTH - c.next;
+    c.next = m_head - SSE_QUEUE_DEPTH;
+  }
+  return true;
+}
+
+// ----------------------------------------------------
+// Senden
+// ----------------------------------------------------
+void EventStream::pump() {
+  for (uint8_t i = 0; i < SSE_MAX_CLIENTS; i++) {
+    Client &c = m_clients[i];
+    if (!c.used) continue;
+    if (!(c.request ? readRequest(c) : flush(c))) {
+      c.client.stop();
+      c.client = WiFiClient();
+      c.used   = false;
+    }
+  }
+}
+
+// Anfragezeile muss mit SSE_PATH beginnen, der Rest des Headers
+// wird bis zur Leerzeile überlesen
+bool EventStream::readRequest(Client &c) {
+  char buf[64];
+  for (;;) {
+    int n = recv(c.client.fd(), buf, sizeof(buf), MSG_DONTWAIT);
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      return millis() - c.sinceMs < SSE_REQUEST_TIMEOUT_MS;
+    }
+    if (n <= 0) return false;   // getrennt oder Fehler
+
+    for (int k = 0; k < n; k++) {
+      char ch = buf[k];
+      if (c.parsed < sizeof(SSE_PATH)) {
+        bool ok = c.parsed < sizeof(SSE_PATH) - 1 ? ch == SSE_PATH[c.parsed]
+                                                  : (ch == ' ' || ch == '?');
+        if (!ok) {
+          reject(c.client, SSE_NOT_FOUND, sizeof(SSE_NOT_FOUND) - 1);
+          return false;
+        }
+        c.parsed++;
+      }
+
+      if (ch == '\r')                     c.eol = (c.eol == 2) ? 3 : 1;
+      else if (ch == '\n' && (c.eol & 1)) c.eol++;
+      else                                c.eol = 0;
+      if (c.eol < 4) continue;
+
+      // Anfrage vollständig: Header einreihen, ab dem nächsten
+      // Ereignis streamen (ältere im Ring können veraltet sein)
+      c.request = false;
+      c.next    = m_head;
+      memcpy(c.out, SSE_HEADER, sizeof(SSE_HEADER) - 1);
+      c.outLength = sizeof(SSE_HEADER) - 1;
+      c.outOffset = 0;
+      return flush(c);
+    }
+  }
+}
+
+// Sendepuffer leeren und nachfüllen, bis der Socket voll ist
+// oder nichts mehr ansteht
+bool EventStream::flush(Client &c) {
+  for (;;) {
+    if (c.outOffset == c.outLength) {
+      if (c.next == m_head) return true;   // nichts offen
+      const Event &e = m_events[c.next % SSE_QUEUE_DEPTH];
+      memcpy(c.out, e.text, e.length);
+      c.outLength = e.length;
+      c.outOffset = 0;
+      c.next++;
+    }
+
+    int sent = send(c.client.fd(), c.out + c.outOffset, c.outLength - c.outOffset, MSG_DONTWAIT);
+    if (sent > 0) {
+      c.outOffset += sent;
+      continue;
+    }
+    if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return true;   // später weiter
+    return false;   // getrennt oder Fehler
+  }
+}
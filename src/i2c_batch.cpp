@@ -0,0 +1,63 @@
+#include "i2c_batch.h"
+
+void I2cBatch::clear() {
+  if (m_cmd) i2c_cmd_link_delete_static(m_cmd);
+  m_cmd      = i2c_cmd_link_create_static(m_link, sizeof(m_link));
+  m_ops      = 0;
+  m_overflow = (m_cmd == NULL);
+}
+
+// ----------------------------------------------------
+// Zugriffe einreihen
+// ----------------------------------------------------
+// Der erste Start ist ein normaler Start, alle weiteren
+// werden als Repeated Start ausgeführt.
+bool I2cBatch::start(uint8_t addr, bool read) {
+  if (m_overflow || m_ops >= I2C_BATCH_MAX_OPS) {
+    m_overflow = true;
+    return false;
+  }
+  m_ops++;
+  if (i2c_master_start(m_cmd) != ESP_OK ||
+      i2c_master_write_byte(m_cmd, (addr << 1) | (read ? I2C_MASTER_READ : I2C_MASTER_WRITE), true) != ESP_OK) {
+    m_overflow = true;
+    return false;
+  }
+  return true;
+}
+
+bool I2cBatch::writeByte(uint8_t addr, uint8_t value) {
+  if (!start(addr, false)) return false;
+  if (i2c_master_write_byte(m_cmd, value, true) != ESP_OK) m_overflow = true;
+  return !m_overflow;
+}
+
+bool I2cBatch::readRegister(uint8_t addr, uint8_t reg, uint8_t dest[2], bool pointer) {
+  if (pointer) {
+    if (!start(addr, false)) return false;
+    if (i2c_master_write_byte(m_cmd, reg, true) != ESP_OK) m_overflow = true;
+  }
+  if (!start(addr, true)) return false;
+  if (i2c_master_read(m_cmd, dest, 2, I2C_MASTER_LAST_NACK) != ESP_OK) m_overflow = true;
+  return !m_overflow;
+}
+
+// ----------------------------------------------------
+// Ausführen
+// ----------------------------------------------------
+int I2cBatch::execute() {
+  if (m_overflow) {
+    clear();
+    return -ENOMEM;
+  }
+  if (m_ops == 0) return 0;
+
+  esp_err_t err = i2c_master_stop(m_cmd);
+  if (err == ESP_OK) err = i2c_master_cmd_begin(m_port, m_cmd, pdMS_TO_TICKS(I2C_BATCH_TIMEOUT_MS));
+  clear();
+
+  if (err == ESP_OK)                return 0;
+  if (err == ESP_ERR_INVALID_STATE) return -ENOTSUP;   // Port ohne IDF-Treiber
+  if (err == ESP_ERR_NO_MEM)        return -ENOMEM;
+  return -EIO;
+}
@@ -0,0 +1,197 @@
+#include "json_writer.h"
+
+#include <opt3001.h>
+
+JsonWriter::JsonWriter(char *buf, size_t size) : m_buf(buf), m_size(size) {
+  reset();
+}
+
+void JsonWriter::reset() {
+  m_len      = 0;
+  m_overflow = false;
+  m_depth    = 0;
+  m_afterKey = false;
+  m_first    = 1;
+  if (m_size) m_buf[0] = '\0';
+}
+
+// ----------------------------------------------------
+// Struktur
+// ----------------------------------------------------
+JsonWriter &JsonWriter::beginArray() {
+  separator();
+  put('[');
+  if (m_depth + 1 < JSON_MAX_DEPTH) m_depth++;
+  m_first |= 1 << m_depth;
+  return *this;
+}
+
+JsonWriter &JsonWriter::endArray() {
+  put(']');
+  if (m_depth) m_depth--;
+  return *this;
+}
+
+JsonWriter &JsonWriter::beginObject() {
+  separator();
+  put('{');
+  if (m_depth + 1 < JSON_MAX_DEPTH) m_depth++;
+  m_first |= 1 << m_depth;
+  return *this;
+}
+
+JsonWriter &JsonWriter::endObject() {
+  put('}');
+  if (m_depth) m_depth--;
+  return *this;
+}
+
+JsonWriter &JsonWriter::key(const char *name) {
+  separator();
+  put('"');
+  put(name);
+  put("\":");
+  m_afterKey = true;
+  return *this;
+}
+
+// ----------------------------------------------------
+// Werte
+// ----------------------------------------------------
+JsonWriter &JsonWriter::value(uint32_t v) {
+  separator();
+  putUnsigned(v);
+  return *this;
+}
+
+JsonWriter &JsonWriter::value(bool v) {
+  separator();
+  put(v ? "true" : "false");
+  return *this;
+}
+
+// Nur feste Bezeichner (Zustandsnamen, Schlüssel): kein Escaping
+JsonWriter &JsonWriter::value(const char *s) {
+  separator();
+  put('"');
+  put(s);
+  put('"');
+  return *this;
+}
+
+JsonWriter &JsonWriter::null() {
+  separator();
+  put("null");
+  return *this;
+}
+
+JsonWriter &JsonWriter::lux(uint16_t raw) {
+  separator();
+  char digits[JSON_LUX_MAX_LEN];
+  formatLux(digits, raw);
+  put(digits);
+  return *this;
+}
+
+// ----------------------------------------------------
+// Lux als Festkomma
+// ----------------------------------------------------
+// Centilux = Mantisse << Exponent ist exakt; gerundet wird
+// auf Zehntel. Bisher lief der Wert über float und
+// dtostrf(lux, 3, 1): +0.05 in double, dann Ziffern per
+// Abschneiden. Das ergibt "kaufmännisch gerundet auf den
+// Float-Wert", d. h. nur bei Centilux auf ...5 (Exponent 0,
+// sonst ist Centilux gerade) entscheidet, ob der Float über
+// oder unter dem Dezimalwert liegt:
+//  - nicht exakt darstellbar: Float auf 24 Bit Mantisse
+//    nachrechnen, Rest der Division zeigt die Richtung
+//  - exakte Viertel (n.25, n.75): dtostrf folgt dem
+//    Rundungsrauschen von double, Tabelle je n
+// Gegen dtostrf geprüft für alle Rohwerte mit Exponent
+// 0..12; 13..15 liefert der Sensor nicht (> 167 klx).
+//
+// Herleitung der Tabellen: Viertel mit Centilux auf ...5 gibt
+// es nur bei Exponent 0, also n = 0..40 (4095 Centilux). Der
+// Float n.25 bzw. n.75 ist exakt; dtostrf rechnet in double
+//   x = (n.25 + 1.0 / 20) / 10^k   (k: Stellen vor dem Komma - 1)
+// und zieht dann je Ziffer ab und multipliziert mit 10.
+// 1/20 ist in double nicht exakt, jede dieser Operationen
+// rundet, und wie, hängt von n ab. Bit n ist gesetzt, wenn
+// diese Rechnung für n als letzte Ziffer 3 bzw. 8 ergibt
+// (aufgerundet). Erzeugt und für alle 65536 Rohwerte
+// nachgeprüft mit test/test_json_writer (Referenz-dtostrf).
+static const uint64_t QUARTER_UP_25 = 0x739def03ULL;       // Bit n: n.25 → n.3
+static const uint64_t QUARTER_UP_75 = 0x100ee7fbf03ULL;    // Bit n: n.75 → n.8
+
+static bool halfRoundsUp(uint32_t centilux) {
+  if (centilux % 50 == 25) {
+    uint64_t table = (centilux % 100 == 25) ? QUARTER_UP_25 : QUARTER_UP_75;
+    return (table >> (centilux / 100)) & 1;
+  }
+
+  // Float-Mantisse von centilux / 100: skalieren bis 2^23 <= n / 100 < 2^24
+  uint64_t n = centilux;
+  while (n < (100ULL << 23)) n <<= 1;
+  uint32_t rest = n % 100;
+  return rest > 50 || (rest == 50 && ((n / 100) & 1));   // Float-Rundung: ties to even
+}
+
+size_t JsonWriter::formatLux(char *dest, uint16_t raw) {
+  uint32_t centilux = opt3001::centilux_from_raw(raw);
+  uint32_t tenths   = centilux / 10;
+  uint32_t hundreds = centilux % 10;
+  if (hundreds > 5 || (hundreds == 5 && halfRoundsUp(centilux))) tenths++;
+
+  // Ganzzahlteil rückwärts, dann Nachkommastelle
+  char tmp[JSON_LUX_MAX_LEN];
+  uint8_t n = 0;
+  uint32_t whole = tenths / 10;
+  do {
+    tmp[n++] = '0' + whole % 10;
+    whole /= 10;
+  } while (whole);
+
+  size_t len = 0;
+  while (n) dest[len++] = tmp[--n];
+  dest[len++] = '.';
+  dest[len++] = '0' + tenths % 10;
+  dest[len]   = '\0';
+  return len;
+}
+
+// ----------------------------------------------------
+// Ausgabe
+// ----------------------------------------------------
+// Komma vor jedem Element außer dem ersten einer Ebene und
+// außer dem Wert direkt nach seinem Schlüssel
+void JsonWriter::separator() {
+  if (m_afterKey) {
+    m_afterKey = false;
+    return;
+  }
+  if (m_first & (1 << m_depth)) m_first &= ~(1 << m_depth);
+  else put(',');
+}
+
+void JsonWriter::put(char c) {
+  if (m_len + 1 >= m_size) {
+    m_overflow = true;
+    return;
+  }
+  m_buf[m_len++] = c;
+  m_buf[m_len]   = '\0';
+}
+
+void JsonWriter::put(const char *s) {
+  while (*s) put(*s++);
+}
+
+void JsonWriter::putUnsigned(uint32_t v) {
+  char tmp[10];
+  uint8_t n = 0;
+  do {
+    tmp[n++] = '0' + v % 10;
+    v /= 10;
+  } while (v);
+  while (n) put(tmp[--n]);
+}
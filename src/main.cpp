@@ -6,6 +6,16 @@
 #include <WebServer.h>
 #include <FastLED.h>
 
+#include "topology.h"
+#include "opt3001_array.h"
+#include "lux_frame.h"
+#include "acquisition.h"
+#include "json_writer.h"
+#include "response_cache.h"
+#include "frame_codec.h"
+#include "event_stream.h"
+#include "dashboard_html_gz.h"
+
 // ----------------------------------------------------
 // Ethernet-Konfiguration
 // ----------------------------------------------------
@@ -35,117 +45,291 @@ bool ledG = false;
 bool ledB = false;
 
 // ----------------------------------------------------
-// Sensor- / Mux-Konfiguration
+// Sensoren (Topologie siehe topology.h)
 // ----------------------------------------------------
-const uint8_t NUM_MUXES = 3;
-const uint8_t MUX_ADDR[NUM_MUXES]          = { 0x70, 0x71, 0x72 };
-const uint8_t MUX_CHANNEL_COUNT[NUM_MUXES] = { 8,    8,    4    };
-
-const uint8_t NUM_SENSORS_PER_CHANNEL = 3;
-const uint8_t SENSOR_ADDR[NUM_SENSORS_PER_CHANNEL] = { 0x44, 0x45, 0x46 };
+TwoWire *const I2C_BUS[NUM_I2C_BUSES] = { &Wire, &Wire1 };
 
-#define TOTAL_ROWS 20   // 0 .. 19
+Opt3001Array  busSensors[NUM_I2C_BUSES];    // ein Array je I2C-Bus
+Opt3001Array *sensorArrays[NUM_I2C_BUSES];  // davon benutzte Busse
+uint8_t       numSensorArrays = 0;
+Acquisition   acquisition;   // Scan-Tasks, liefern Frames mit Rohwerten
 
-opt3001 sensor;
-float luxMatrix[TOTAL_ROWS][NUM_SENSORS_PER_CHANNEL];
+// ----------------------------------------------------
+// LEDs aus R/G/B-Flags setzen
+// ----------------------------------------------------
+void applyLedColor() {
+  CRGB c(ledR ? 255 : 0, ledG ? 255 : 0, ledB ? 255 : 0);
+  for (uint8_t i = 0; i < LED_COUNT; i++) statusLeds[i] = c;
+  FastLED.show();
+}
 
 // ----------------------------------------------------
-// I2C-Mux Helfer
+// JSON-Antworten: ein statischer Puffer für alle Endpunkte
+// (der WebServer bearbeitet eine Anfrage nach der anderen),
+// Frame-Antworten zusätzlich im Cache je Frame
 // ----------------------------------------------------
-void selectMuxChannel(uint8_t mux, uint8_t ch) {
-  if (mux >= NUM_MUXES) return;
-  if (ch >= MUX_CHANNEL_COUNT[mux]) return;
-  Wire.beginTransmission(MUX_ADDR[mux]);
-  Wire.write(1 << ch);
-  Wire.endTransmission();
+#define JSON_BUFFER_SIZE 768   // /stats
+
+// Längste mögliche Antworten, Zahlen mit allen Stellen. Ein Feld
+// "key":wert ist Schlüssel + 3 Zeichen + Wert, dazu Kommas/Klammern.
+// Ein Überlauf zur Laufzeit liefert trotzdem nur sendTooLarge().
+#define JSON_UINT_MAX_LEN 10   // 4294967295
+#define JSON_ITEM_MAX_LEN 9    // "\"timeout\"" bzw. Lux bis "1342177.3"
+
+// /stats: 19 Zähler (Schlüssel zusammen 206 Zeichen) und "sensors":{…}
+// mit 5 Zuständen (29 Zeichen, je höchstens 3 Ziffern)
+#define STATS_JSON_MAX_LEN (1 + 206 + 19 * (3 + JSON_UINT_MAX_LEN) + 19 + \
+                            11 + 29 + 5 * (3 + 3) + 4 + 2)
+// /data: [wert,…]; /age kürzer (max. 5 Ziffern bzw. null)
+#define DATA_JSON_MAX_LEN  (2 + TOTAL_SENSORS * JSON_ITEM_MAX_LEN + TOTAL_SENSORS - 1)
+// /times: {"frame_ms":N,"sample_ms":[N,…]}
+#define TIMES_JSON_MAX_LEN (12 + JSON_UINT_MAX_LEN + 14 + \
+                            TOTAL_SENSORS * JSON_UINT_MAX_LEN + TOTAL_SENSORS - 1 + 2)
+
+static_assert(JSON_BUFFER_SIZE >= STATS_JSON_MAX_LEN + 1, "JSON_BUFFER_SIZE zu klein für /stats");
+static_assert(RESPONSE_CACHE_ENTRY_SIZE >= DATA_JSON_MAX_LEN + 1, "Cache-Eintrag zu klein für /data");
+static_assert(RESPONSE_CACHE_ENTRY_SIZE >= TIMES_JSON_MAX_LEN + 1, "Cache-Eintrag zu klein für /times");
+static_assert(RESPONSE_CACHE_ENTRY_SIZE >= FRAME_CODEC_HEADER_LEN + 2 * TOTAL_SENSORS,
+              "Cache-Eintrag zu klein für /data.bin");
+
+static char jsonBuffer[JSON_BUFFER_SIZE];
+JsonWriter  json(jsonBuffer, sizeof(jsonBuffer));
+ResponseCache responseCache;
+
+void sendTooLarge() {
+  server.send(500, "application/json", "{\"error\":\"response too large\"}");
 }
 
-void disableMux(uint8_t mux) {
-  if (mux >= NUM_MUXES) return;
-  Wire.beginTransmission(MUX_ADDR[mux]);
-  Wire.write(0x00);
-  Wire.endTransmission();
+void sendJson(int code = 200) {
+  if (json.overflow()) {
+    sendTooLarge();
+    return;
+  }
+  server.send_P(code, "application/json", json.c_str(), json.length());
+}
+
+// Frame-Antwort fertig geschrieben: im Cache ablegen und senden
+void sendCachedJson(uint8_t format, uint32_t seq, const JsonWriter &out) {
+  if (out.overflow()) {
+    sendTooLarge();
+    return;
+  }
+  const CachedResponse *r = responseCache.commit(format, seq, out.length());
+  server.send_P(200, "application/json", r->data, r->length);
+}
+
+// Treffer direkt senden; false = Handler muss neu serialisieren
+bool sendFromCache(uint8_t format, uint32_t seq, const char *type = "application/json") {
+  const CachedResponse *r = responseCache.find(format, seq);
+  if (!r) return false;
+  server.send_P(200, type, r->data, r->length);
+  return true;
 }
 
 // ----------------------------------------------------
-// OPT3001 Reset
+// /data → flaches Array UMGEKEHRT (Index 0 = oben)
+// Fehlende Werte als Zustand: "missing", "suspect",
+// "failed" oder "timeout"
 // ----------------------------------------------------
-void resetOpt3001(uint8_t addr) {
-  Wire.beginTransmission(addr);
-  Wire.write(0x01);
-  Wire.write(0xC8);
-  Wire.write(0x10);
-  Wire.endTransmission();
-  delay(5);
-}
+void handleData() {
+  LuxFrame luxFrame;
+  if (!acquisition.latest(luxFrame)) luxFrame.clear();
+  if (sendFromCache(RESPONSE_DATA_JSON, luxFrame.seq)) return;
 
-void resetAllSensors() {
-  for (uint8_t m = 0; m < NUM_MUXES; m++) {
-    for (uint8_t ch = 0; ch < MUX_CHANNEL_COUNT[m]; ch++) {
-      selectMuxChannel(m, ch);
-      for (uint8_t i = 0; i < NUM_SENSORS_PER_CHANNEL; i++) {
-        resetOpt3001(SENSOR_ADDR[i]);
-      }
+  JsonWriter out(responseCache.begin(RESPONSE_DATA_JSON), RESPONSE_CACHE_ENTRY_SIZE);
+  out.beginArray();
+  for (int r = TOTAL_ROWS - 1; r >= 0; r--) {
+    for (uint8_t c = 0; c < NUM_SENSORS_PER_CHANNEL; c++) {
+      if (luxFrame.isValid(r, c)) out.lux(luxFrame.raw[r][c]);
+      else out.value(sensorCodeName(luxFrame.code[r][c]));
     }
-    disableMux(m);
   }
+  out.endArray();
+  sendCachedJson(RESPONSE_DATA_JSON, luxFrame.seq, out);
 }
 
 // ----------------------------------------------------
-// LEDs aus R/G/B-Flags setzen
+// /data.bin → Frame im Binärformat (frame_codec.h):
+// Rohregister statt Text, Zeile 0 zuerst, mit seq und
+// Scan-Zeitraum
 // ----------------------------------------------------
-void applyLedColor() {
-  CRGB c(ledR ? 255 : 0, ledG ? 255 : 0, ledB ? 255 : 0);
-  for (uint8_t i = 0; i < LED_COUNT; i++) statusLeds[i] = c;
-  FastLED.show();
+void frameToBinary(const LuxFrame &luxFrame, BinaryFrame &bin) {
+  bin.rows        = TOTAL_ROWS;
+  bin.cols        = NUM_SENSORS_PER_CHANNEL;
+  bin.seq         = luxFrame.seq;
+  bin.timestampMs = luxFrame.timestamp;
+  bin.scanStartUs = luxFrame.scanStartUs;
+  bin.scanEndUs   = luxFrame.scanEndUs;
+  bin.valid       = luxFrame.valid;
+  for (uint8_t r = 0; r < TOTAL_ROWS; r++) {
+    for (uint8_t c = 0; c < NUM_SENSORS_PER_CHANNEL; c++) {
+      bin.value[LuxFrame::index(r, c)] = luxFrame.isValid(r, c) ? luxFrame.raw[r][c] : luxFrame.code[r][c];
+    }
+  }
 }
 
-// ----------------------------------------------------
-// Sensorwerte aktualisieren
-// ----------------------------------------------------
-void updateLuxMatrix() {
-  uint8_t row = 0;
+// Binärframe aus dem Cache, bei Bedarf erzeugt (/data.bin und /events)
+const CachedResponse *binaryFrame(const LuxFrame &luxFrame) {
+  const CachedResponse *r = responseCache.find(RESPONSE_DATA_BIN, luxFrame.seq);
+  if (r) return r;
 
-  for (uint8_t m = 0; m < NUM_MUXES; m++) {
-    for (uint8_t ch = 0; ch < MUX_CHANNEL_COUNT[m]; ch++) {
-      if (row >= TOTAL_ROWS) break;
+  BinaryFrame bin;
+  frameToBinary(luxFrame, bin);
+  char *buf = responseCache.begin(RESPONSE_DATA_BIN);
+  size_t len = frameCodecEncode(bin, (uint8_t *)buf, RESPONSE_CACHE_ENTRY_SIZE);
+  return responseCache.commit(RESPONSE_DATA_BIN, luxFrame.seq, len);
+}
 
-      selectMuxChannel(m, ch);
-      delayMicroseconds(500);
+void handleDataBin() {
+  LuxFrame luxFrame;
+  if (!acquisition.latest(luxFrame)) luxFrame.clear();
 
-      for (uint8_t i = 0; i < NUM_SENSORS_PER_CHANNEL; i++) {
-        float lux = NAN;
-        if (sensor.setup(Wire, SENSOR_ADDR[i]) == 0) {
-          if (sensor.lux_read(&lux) != 0) lux = NAN;
-        }
-        luxMatrix[row][i] = lux;
-      }
-      row++;
+  const CachedResponse *r = binaryFrame(luxFrame);
+  server.send_P(200, "application/octet-stream", r->data, r->length);
+}
+
+// ----------------------------------------------------
+// /events → Server-Sent Events, je neuem Frame ein
+// Ereignis "frame" (Binärformat als Base64). Eigener
+// Server auf SSE_PORT, nicht über den WebServer
+// (siehe event_stream.h).
+// ----------------------------------------------------
+EventStream eventStream;
+uint32_t    streamedFrames = 0;   // acquisition.frames() beim letzten Ereignis
+
+// Aus loop(): neuen Frame einreihen, Clients bedienen.
+// Ohne Abonnenten wird nichts gerendert und der Cache nicht
+// befragt (sonst zählt jeder Frame als cache_miss); ein neuer
+// Abonnent beginnt mit dem nächsten veröffentlichten Frame
+void serviceEvents() {
+  eventStream.accept();
+  if (eventStream.clients() == 0) return;
+
+  uint32_t published = acquisition.frames();
+  if (published != streamedFrames) {
+    LuxFrame luxFrame;
+    if (acquisition.latest(luxFrame)) {
+      const CachedResponse *r = binaryFrame(luxFrame);
+      eventStream.publish(luxFrame.seq, (const uint8_t *)r->data, r->length);
     }
-    disableMux(m);
+    streamedFrames = published;
   }
+  eventStream.pump();
 }
 
 // ----------------------------------------------------
-// /data → flaches Array UMGEKEHRT (Index 0 = oben)
+// /age → Alter jedes Werts in ms, gleiche Reihenfolge wie /data
 // ----------------------------------------------------
-void handleData() {
-  String json;
-  json.reserve(4000);
-  json += "[";
-  bool first = true;
+void handleAge() {
+  LuxFrame luxFrame;
+  if (!acquisition.latest(luxFrame)) luxFrame.clear();
+  if (sendFromCache(RESPONSE_AGE_JSON, luxFrame.seq)) return;
+
+  JsonWriter out(responseCache.begin(RESPONSE_AGE_JSON), RESPONSE_CACHE_ENTRY_SIZE);
+  out.beginArray();
+  for (int r = TOTAL_ROWS - 1; r >= 0; r--) {
+    for (uint8_t c = 0; c < NUM_SENSORS_PER_CHANNEL; c++) {
+      if (luxFrame.isValid(r, c)) out.value((uint32_t)luxFrame.ageMs[r][c]);
+      else out.null();
+    }
+  }
+  out.endArray();
+  sendCachedJson(RESPONSE_AGE_JSON, luxFrame.seq, out);
+}
 
+// ----------------------------------------------------
+// /times → Zeitpunkt jedes Werts (millis()), gleiche
+// Reihenfolge wie /data; für ungleichmäßige Abtastung
+// (Fovea, Fenster-Modus)
+// ----------------------------------------------------
+void handleTimes() {
+  LuxFrame luxFrame;
+  if (!acquisition.latest(luxFrame)) luxFrame.clear();
+  if (sendFromCache(RESPONSE_TIMES_JSON, luxFrame.seq)) return;
+
+  JsonWriter out(responseCache.begin(RESPONSE_TIMES_JSON), RESPONSE_CACHE_ENTRY_SIZE);
+  out.beginObject();
+  out.key("frame_ms").value(luxFrame.timestamp);
+  out.key("sample_ms").beginArray();
   for (int r = TOTAL_ROWS - 1; r >= 0; r--) {
     for (uint8_t c = 0; c < NUM_SENSORS_PER_CHANNEL; c++) {
-      if (!first) json += ",";
-      first = false;
-      float v = luxMatrix[r][c];
-      json += isnan(v) ? "null" : String(v, 1);
+      if (luxFrame.isValid(r, c)) out.value(luxFrame.timestamp - luxFrame.ageMs[r][c]);
+      else out.null();
     }
   }
+  out.endArray();
+  out.endObject();
+  sendCachedJson(RESPONSE_TIMES_JSON, luxFrame.seq, out);
+}
+
+// ----------------------------------------------------
+// /rescan → Bestückung neu vermessen und im NVS speichern
+// ----------------------------------------------------
+void handleRescan() {
+  acquisition.requestRescan();
+  json.reset();
+  json.beginObject().key("rescan").value("queued").endObject();
+  sendJson(202);
+}
+
+// ----------------------------------------------------
+// /stats → Zähler der Erfassung
+// ----------------------------------------------------
+void handleStats() {
+  uint32_t muxWrites = 0, muxSaved = 0, muxCorruptions = 0, settleBumps = 0, settleDecays = 0;
+  uint32_t recoveries = 0, recoveryFailures = 0;
+  uint32_t windowChecks = 0, windowReads = 0, hotplugged = 0;
+  for (uint8_t i = 0; i < numSensorArrays; i++) {
+    hotplugged       += sensorArrays[i]->hotplugged();
+    windowChecks     += sensorArrays[i]->windowChecks();
+    windowReads      += sensorArrays[i]->windowReads();
+    recoveries       += sensorArrays[i]->recovery().recoveries();
+    recoveryFailures += sensorArrays[i]->recovery().failures();
+
+    const MuxBank &mux = sensorArrays[i]->mux();
+    muxWrites      += mux.writes();
+    muxSaved       += mux.saved();
+    muxCorruptions += mux.corruptions();
+    settleBumps    += mux.settleBumps();
+    settleDecays   += mux.settleDecays();
+  }
 
-  json += "]";
-  server.send(200, "application/json", json);
+  // Sensorzustände aus dem letzten Frame
+  uint8_t codes[CODE_TIMEOUT + 1] = { 0 };
+  LuxFrame luxFrame;
+  if (!acquisition.latest(luxFrame)) luxFrame.clear();
+  for (uint8_t r = 0; r < TOTAL_ROWS; r++) {
+    for (uint8_t c = 0; c < NUM_SENSORS_PER_CHANNEL; c++) codes[luxFrame.code[r][c]]++;
+  }
+
+  json.reset();
+  json.beginObject();
+  json.key("frames").value(acquisition.frames());
+  json.key("dropped").value(acquisition.dropped());
+  json.key("scan_us").value(acquisition.scanUs());
+  json.key("buses").value((uint32_t)numSensorArrays);
+  json.key("mux_writes").value(muxWrites);
+  json.key("mux_saved").value(muxSaved);
+  json.key("mux_corruptions").value(muxCorruptions);
+  json.key("settle_bumps").value(settleBumps);
+  json.key("settle_decays").value(settleDecays);
+  json.key("bus_recoveries").value(recoveries);
+  json.key("bus_recovery_failures").value(recoveryFailures);
+  json.key("window_checks").value(windowChecks);
+  json.key("window_reads").value(windowReads);
+  json.key("hot_rows").value(acquisition.hotRows());
+  json.key("hotplugged").value(hotplugged);
+  json.key("cache_hits").value(responseCache.hits());
+  json.key("cache_misses").value(responseCache.misses());
+  json.key("sse_clients").value((uint32_t)eventStream.clients());
+  json.key("sse_dropped").value(eventStream.dropped());
+  json.key("sensors").beginObject();
+  for (uint8_t code = CODE_OK; code <= CODE_TIMEOUT; code++) {
+    json.key(sensorCodeName(code)).value((uint32_t)codes[code]);
+  }
+  json.endObject();
+  json.endObject();
+  sendJson();
 }
 
 // ----------------------------------------------------
@@ -165,191 +349,130 @@ void handleLed() {
   if (server.hasArg("b")) ledB = parseBool(server.arg("b"), ledB);
   applyLedColor();
 
-  server.send(200, "application/json",
-    "{\"r\":" + String(ledR ? "true" : "false") +
-    ",\"g\":" + String(ledG ? "true" : "false") +
-    ",\"b\":" + String(ledB ? "true" : "false") + "}"
-  );
+  json.reset();
+  json.beginObject().key("r").value(ledR).key("g").value(ledG).key("b").value(ledB).endObject();
+  sendJson();
 }
 
 // ----------------------------------------------------
-// WebUI – Grafik + Werte nebeneinander
-// Mit Index-Zahlen 1..60 über jedem Kreis
+// /mode?snapshot=1 → global synchrone Single-Shot-Frames
+// /mode?window=1   → nur Änderungen lesen (Limit-Register)
+// /mode?fovea=1&max_stale_ms=500 → ruhige Zeilen seltener
+// (max_stale_ms wird auf 1..FOVEA_COLD_CONVERSIONS Wandlungs-
+// zeiten begrenzt, die Antwort nennt den wirksamen Wert)
 // ----------------------------------------------------
-void handleRoot() {
-  String html;
-  html.reserve(17000);
-
-  const int cell = 40;
-  const int rad  = 14;
-  const int rows = TOTAL_ROWS;
-  const int cols = NUM_SENSORS_PER_CHANNEL;
-  const int topMargin = 70;
-
-  html += F(
-    "<!DOCTYPE html><html><head><meta charset='utf-8'>"
-    "<meta name='viewport' content='width=device-width,initial-scale=1'>"
-    "<style>"
-    "body{background:#111;color:#eee;font-family:Arial,sans-serif;margin:0;padding:0;text-align:center}"
-    "h2{margin-top:12px;margin-bottom:4px}"
-    "p{margin:4px;font-size:13px}"
-    ".wrap{display:flex;justify-content:center;align-items:flex-start;gap:24px;margin:10px;flex-wrap:wrap}"
-    "svg{background:#222;border-radius:8px}"
-    "circle{stroke:#444;stroke-width:1}"
-    ".lbl{fill:#ccc;font-size:11px}"
-    ".title{fill:#0f0;font-size:14px;font-weight:bold}"
-    ".idx{fill:#ddd;font-size:10px;font-weight:bold;text-anchor:middle;dominant-baseline:middle}"
-    "table{border-collapse:collapse;background:#222;border-radius:8px;overflow:hidden;font-size:12px}"
-    "th,td{border:1px solid #444;padding:2px 6px;text-align:right}"
-    "th{background:#333;font-weight:bold}"
-    "tr:nth-child(even){background:#262626}"
-    "tr:nth-child(odd){background:#1d1d1d}"
-    ".rowlabel{text-align:center;font-weight:bold;color:#aaa}"
-    "</style></head><body>"
-    "<h2>Lux-Matrix (logarithmisch)</h2>"
-    "<p>0 lx = schwarz → grün → gelb → rot</p>"
-    "<p>/data: flaches Array (60) – Index 0 = oberste Reihe im GUI</p>"
-  );
-
-  html += "<div class='wrap'>";
-
-  // --- SVG ---
-  html += "<svg width='240' height='900'>";
-  html += "<text class='title' x='120' y='30' text-anchor='middle'>LOGIC SIDE</text>";
-
-  // Anzeige-Reihen (oben->unten): Row 19..0
-  // Datenindex im flachen Array: dispRow*3 + col   (dispRow=0 ist oben)
-  // Index-Label: +1 für 1..60
-  for (int dispRow = 0; dispRow < rows; dispRow++) {
-    int logicalRow = rows - 1 - dispRow;  // 19..0
-    int cy = topMargin + dispRow * cell;
-
-    // Row-Label links
-    html += "<text class='lbl' x='15' y='" + String(cy + 4) + "'>" + String(logicalRow) + "</text>";
-
-    for (int col = 0; col < cols; col++) {
-      int cx = 70 + col * cell;
-
-      // Kreis-ID bleibt logisch (Row/Col), damit JS einfach bleibt
-      String cid = "c" + String(logicalRow) + "_" + String(col);
-      html += "<circle id='" + cid +
-              "' cx='" + String(cx) +
-              "' cy='" + String(cy) +
-              "' r='" + String(rad) + "' fill='#000'/>";
-
-      // Index-Zahl 1..60 (statisch)
-      int idxLabel = dispRow * cols + col + 1; // 1..60 von oben nach unten
-      html += "<text class='idx' x='" + String(cx) + "' y='" + String(cy - 22) + "'>";
-      html += String(idxLabel);
-      html += "</text>";
-    }
+void handleMode() {
+  if (server.hasArg("snapshot")) {
+    acquisition.setSnapshot(parseBool(server.arg("snapshot"), acquisition.snapshot()));
   }
-  html += "</svg>";
-
-  // --- Tabelle ---
-  html += "<table><thead><tr>";
-  html += "<th>Row</th><th>S0</th><th>S1</th><th>S2</th>";
-  html += "</tr></thead><tbody>";
-
-  for (int dispRow = 0; dispRow < rows; dispRow++) {
-    int logicalRow = rows - 1 - dispRow;  // 19..0
-    html += "<tr>";
-    html += "<td class='rowlabel'>" + String(logicalRow) + "</td>";
-    for (int col = 0; col < cols; col++) {
-      String id = "v" + String(logicalRow) + "_" + String(col);
-      html += "<td id='" + id + "'>--.-</td>";
-    }
-    html += "</tr>";
+  if (server.hasArg("window")) {
+    acquisition.setWindow(parseBool(server.arg("window"), acquisition.window()));
+  }
+  if (server.hasArg("fovea")) {
+    acquisition.setFovea(parseBool(server.arg("fovea"), acquisition.fovea()));
+  }
+  if (server.hasArg("max_stale_ms")) {
+    long ms = server.arg("max_stale_ms").toInt();
+    if (ms > 0) acquisition.setMaxStaleMs(ms > 0xFFFF ? 0xFFFF : ms);
+  }
+  json.reset();
+  json.beginObject();
+  json.key("snapshot").value(acquisition.snapshot());
+  json.key("window").value(acquisition.window());
+  json.key("fovea").value(acquisition.fovea());
+  json.key("max_stale_ms").value((uint32_t)acquisition.maxStaleMs());
+  json.endObject();
+  sendJson();
+}
+
+// ----------------------------------------------------
+// /topology → Raster für das Dashboard
+// ----------------------------------------------------
+void handleTopology() {
+  json.reset();
+  json.beginObject();
+  json.key("rows").value((uint32_t)TOTAL_ROWS);
+  json.key("cols").value((uint32_t)NUM_SENSORS_PER_CHANNEL);
+  json.key("buses").value((uint32_t)numSensorArrays);
+  json.key("events_port").value((uint32_t)SSE_PORT);
+  json.endObject();
+  sendJson();
+}
+
+// ----------------------------------------------------
+// WebUI – fertig gzip-komprimiert im Flash
+// (web/index.html, Raster und Tabelle baut das JS aus
+// /topology). Kein Heap, keine Formatierung: bei passendem
+// ETag nur 304, sonst die Bytes direkt aus dem Flash.
+// ----------------------------------------------------
+#define DASHBOARD_CACHE_CONTROL "public, max-age=86400"   // danach Revalidierung per ETag
+
+void handleRoot() {
+  server.sendHeader("ETag", DASHBOARD_HTML_GZ_ETAG);
+  server.sendHeader("Cache-Control", DASHBOARD_CACHE_CONTROL);
+
+  if (server.header("If-None-Match") == DASHBOARD_HTML_GZ_ETAG) {
+    server.send(304);
+    return;
   }
-  html += "</tbody></table>";
-
-  html += "</div>"; // wrap
-
-  // --- JS: /data lesen und aktualisieren ---
-  html += F(
-    "<script>"
-    "const rows=20, cols=3;"
-    "function luxColor(v){"
-      "if(v===null||isNaN(v)||v<=0)return '#000';"
-      "if(v>10000)v=10000;"
-      "let t=Math.log10(v)/4;"
-      "let r=0,g=0;"
-      "if(t<0.33){"
-        "let u=t/0.33;"
-        "g=255*u;"
-      "}else if(t<0.66){"
-        "let u=(t-0.33)/0.33;"
-        "r=255*u;g=255;"
-      "}else{"
-        "let u=(t-0.66)/0.34;"
-        "r=255;g=255*(1-u);"
-      "}"
-      "return `rgb(${r|0},${g|0},0)`;"
-    "}"
-    "function update(){"
-      "fetch('/data').then(r=>r.json()).then(a=>{"
-        "for(let dispRow=0;dispRow<rows;dispRow++){"
-          "let logicalRow=(rows-1)-dispRow;"   // 19..0"
-          "for(let col=0;col<cols;col++){"
-            "let idx=dispRow*cols+col;"
-            "let v=a[idx];"
-            "let ce=document.getElementById(`c${logicalRow}_${col}`);"
-            "let ve=document.getElementById(`v${logicalRow}_${col}`);"
-            "if(ce)ce.setAttribute('fill',luxColor(v));"
-            "if(ve)ve.textContent=(v===null||isNaN(v))?'ERR':v.toFixed(1);"
-          "}"
-        "}"
-      "}).catch(e=>console.error(e));"
-    "}"
-    "setInterval(update,300);update();"
-    "</script></body></html>"
-  );
-
-  server.send(200, "text/html", html);
+
+  server.sendHeader("Content-Encoding", "gzip");
+  server.send_P(200, "text/html", (PGM_P)DASHBOARD_HTML_GZ, sizeof(DASHBOARD_HTML_GZ));
 }
 
 // ----------------------------------------------------
 // SETUP / LOOP
 // ----------------------------------------------------
 void setup() {
-  Wire.begin();
+  Wire.begin(I2C0_SDA, I2C0_SCL, I2C_FREQ_HZ);
+  if (busUsed(1)) Wire1.begin(I2C1_SDA, I2C1_SCL, I2C_FREQ_HZ);
 
   FastLED.addLeds<LED_TYPE, LED_PIN, COLOR_ORDER>(statusLeds, LED_COUNT);
   FastLED.setBrightness(LED_BRIGHTNESS);
   applyLedColor();  // Start: alles aus
 
-  resetAllSensors();
-
-  // Sensoren konfigurieren (Continuous Mode)
-  for (uint8_t m = 0; m < NUM_MUXES; m++) {
-    for (uint8_t ch = 0; ch < MUX_CHANNEL_COUNT[m]; ch++) {
-      selectMuxChannel(m, ch);
-      for (uint8_t i = 0; i < NUM_SENSORS_PER_CHANNEL; i++) {
-        if (sensor.setup(Wire, SENSOR_ADDR[i]) == 0 &&
-            sensor.detect() == 0) {
-          sensor.config_set(OPT3001_CONVERSION_TIME_100MS);
-          sensor.conversion_continuous_enable();
-        }
-      }
+  // Je benutztem Bus: Sensortabelle aufbauen, Bestückung aus dem NVS
+  // (erster Boot: Discovery), dann Reset + Continuous Mode (Broadcast
+  // je Mux, Readback der Config je Sensor = Prüfung der Karte)
+  for (uint8_t b = 0; b < NUM_I2C_BUSES; b++) {
+    if (!busUsed(b)) continue;
+    Opt3001Array &sensors = busSensors[b];
+    sensors.begin(*I2C_BUS[b], b);
+    bool cached = sensors.loadMap();   // NVS, sonst Discovery
+    sensors.reset();
+    sensors.configure(OPT3001_CONVERSION_TIME_100MS, true);
+    if (cached && !sensors.mapConsistent()) {
+      sensors.rescan();                // Bestückung geändert
+    } else {
+      sensors.calibrateSettle();
     }
-    disableMux(m);
+    sensorArrays[numSensorArrays++] = &sensors;
   }
 
+  // Ab hier gehören die I2C-Busse den Erfassungs-Tasks
+  acquisition.begin(sensorArrays, numSensorArrays);
+
   ETH.begin(ETH_PHY_ADDR, ETH_PHY_POWER, ETH_PHY_MDC, ETH_PHY_MDIO,
             ETH_PHY_TYPE, ETH_CLK_MODE);
 
+  static const char *collected[] = { "If-None-Match" };
+  server.collectHeaders(collected, 1);
+
   server.on("/", handleRoot);
+  server.on("/topology", handleTopology);
   server.on("/data", handleData);
+  server.on("/data.bin", handleDataBin);
   server.on("/led", handleLed);
+  server.on("/age", handleAge);
+  server.on("/mode", handleMode);
+  server.on("/times", handleTimes);
+  server.on("/rescan", handleRescan);
+  server.on("/stats", handleStats);
   server.begin();
+  eventStream.begin();
 }
 
 void loop() {
   server.handleClient();
-
-  static uint32_t last = 0;
-  if (millis() - last > 100) {
-    last = millis();
-    updateLuxMatrix();
-  }
+  serviceEvents();
 }
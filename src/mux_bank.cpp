@@ -0,0 +1,223 @@
+#include "mux_bank.h"
+
+static_assert(NUM_MUXES <= 8, "m_known fasst max. 8 Muxe");
+
+void MuxBank::begin(TwoWire &wire, uint8_t bus) {
+  m_wire   = &wire;
+  m_known  = 0;
+  m_member = 0;
+  memset(m_mask, 0, sizeof(m_mask));
+  for (uint8_t m = 0; m < NUM_MUXES; m++) {
+    if (MUX_BUS[m] == bus) m_member |= 1 << m;
+    for (uint8_t ch = 0; ch < MUX_MAX_CHANNELS; ch++) {
+      m_settleUs[m][ch]      = MUX_SETTLE_DEFAULT_US;
+      m_settleFloorUs[m][ch] = MUX_SETTLE_DEFAULT_US;
+      m_settleClean[m][ch]   = 0;
+    }
+  }
+}
+
+// ----------------------------------------------------
+// Auswahl
+// ----------------------------------------------------
+int MuxBank::select(uint8_t mux, uint8_t ch) {
+  if (!owns(mux)) return -EINVAL;
+  if (ch >= MUX_CHANNEL_COUNT[mux]) return -EINVAL;
+  return selectMask(mux, 1 << ch);
+}
+
+int MuxBank::selectMask(uint8_t mux, uint8_t mask) {
+  if (!owns(mux)) return -EINVAL;
+
+  // Erst die anderen aus, damit nie zwei Muxe gleichzeitig aktiv sind
+  int res = disableOthers(mux);
+  if (res < 0) return res;
+  int sel = setMask(mux, mask);
+  if (sel < 0) return sel;
+  if (sel) settle(mux, mask);
+  return (res | sel) ? 1 : 0;
+}
+
+int MuxBank::openAll() {
+  int changed = 0;
+  for (uint8_t m = 0; m < NUM_MUXES; m++) {
+    if (!owns(m)) continue;
+    uint8_t all = (1 << MUX_CHANNEL_COUNT[m]) - 1;
+    int res = setMask(m, all);
+    if (res < 0) return res;
+    if (res) settle(m, all);
+    changed |= res;
+  }
+  return changed;
+}
+
+int MuxBank::disableAll() {
+  return disableOthers(NUM_MUXES);
+}
+
+int MuxBank::disableOthers(uint8_t keep) {
+  int changed = 0;
+  for (uint8_t m = 0; m < NUM_MUXES; m++) {
+    if (m == keep || !owns(m)) continue;
+    int res = setMask(m, 0x00);
+    if (res < 0) return res;
+    changed |= res;
+  }
+  return changed;
+}
+
+// ----------------------------------------------------
+// Auswahl als extern ausgeführte Schreibzugriffe
+// ----------------------------------------------------
+// Gleiche Reihenfolge wie selectMask(): erst die anderen
+// Muxe aus, dann der Kanal. Der Cache wird erst mit
+// applySelect() nachgeführt. Die Masken gelten erst nach
+// dem STOP: in einer eigenen Transaktion ausführen.
+uint8_t MuxBank::planSelect(uint8_t mux, uint8_t ch, MuxWrite out[NUM_MUXES]) {
+  uint8_t n = 0;
+  if (!owns(mux) || ch >= MUX_CHANNEL_COUNT[mux]) return 0;
+
+  for (uint8_t m = 0; m < NUM_MUXES; m++) {
+    if (m == mux || !owns(m)) continue;
+    if ((m_known & (1 << m)) && m_mask[m] == 0x00) continue;
+    out[n].addr = MUX_ADDR[m];
+    out[n].mask = 0x00;
+    n++;
+  }
+  if (!(m_known & (1 << mux)) || m_mask[mux] != (1 << ch)) {
+    out[n].addr = MUX_ADDR[mux];
+    out[n].mask = 1 << ch;
+    n++;
+  }
+  return n;
+}
+
+void MuxBank::applySelect(uint8_t mux, uint8_t ch, bool ok) {
+  for (uint8_t m = 0; m < NUM_MUXES; m++) {
+    if (!owns(m)) continue;
+    uint8_t mask = (m == mux) ? (1 << ch) : 0x00;
+
+    if ((m_known & (1 << m)) && m_mask[m] == mask) {
+      m_saved.fetch_add(1, std::memory_order_relaxed);
+      continue;
+    }
+    m_writes.fetch_add(1, std::memory_order_relaxed);
+    if (ok) {
+      m_mask[m] = mask;
+      m_known |= 1 << m;
+    } else {
+      m_known &= ~(1 << m);   // unbekannt, welcher Zugriff fehlschlug
+    }
+  }
+}
+
+// ----------------------------------------------------
+// Settle-Modell
+// ----------------------------------------------------
+void MuxBank::settle(uint8_t mux, uint8_t mask) {
+  uint16_t us = 0;
+  for (uint8_t ch = 0; ch < MUX_CHANNEL_COUNT[mux]; ch++) {
+    if ((mask & (1 << ch)) && m_settleUs[mux][ch] > us) us = m_settleUs[mux][ch];
+  }
+  if (us) delayMicroseconds(us);
+}
+
+void MuxBank::setSettleUs(uint8_t mux, uint8_t ch, uint16_t us) {
+  m_settleUs[mux][ch]      = us;
+  m_settleFloorUs[mux][ch] = us;
+  m_settleClean[mux][ch]   = 0;
+}
+
+void MuxBank::bumpSettle(uint8_t mux, uint8_t ch) {
+  if (mux >= NUM_MUXES || ch >= MUX_CHANNEL_COUNT[mux]) return;
+  m_settleClean[mux][ch] = 0;
+  uint16_t &us = m_settleUs[mux][ch];
+  if (us >= MUX_SETTLE_MAX_US) return;
+
+  uint32_t next = us * 2;
+  if (next < (uint32_t)us + MUX_SETTLE_MIN_BUMP) next = us + MUX_SETTLE_MIN_BUMP;
+  us = next > MUX_SETTLE_MAX_US ? MUX_SETTLE_MAX_US : next;
+  m_settleBumps.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MuxBank::settleOk(uint8_t mux, uint8_t ch) {
+  if (mux >= NUM_MUXES || ch >= MUX_CHANNEL_COUNT[mux]) return;
+  uint16_t &us   = m_settleUs[mux][ch];
+  uint16_t floor = m_settleFloorUs[mux][ch];
+  if (us <= floor) return;
+  if (++m_settleClean[mux][ch] < MUX_SETTLE_DECAY_SELECTS) return;
+
+  m_settleClean[mux][ch] = 0;
+  us = us / 2 > floor ? us / 2 : floor;
+  m_settleDecays.fetch_add(1, std::memory_order_relaxed);
+}
+
+// ----------------------------------------------------
+// Gecachter Schreibzugriff
+// ----------------------------------------------------
+int MuxBank::setMask(uint8_t mux, uint8_t mask) {
+  if ((m_known & (1 << mux)) && m_mask[mux] == mask) {
+    m_saved.fetch_add(1, std::memory_order_relaxed);
+    return 0;
+  }
+
+  m_wire->beginTransmission(MUX_ADDR[mux]);
+  m_wire->write(mask);
+  m_writes.fetch_add(1, std::memory_order_relaxed);
+  uint8_t res = m_wire->endTransmission();
+  if (res != 0) {
+    m_known &= ~(1 << mux);   // Zustand unbekannt
+    if (BusRecovery::isBusError(res)) m_busFault = true;
+    return -EIO;
+  }
+
+  m_mask[mux] = mask;
+  m_known |= 1 << mux;
+  return 1;
+}
+
+// ----------------------------------------------------
+// Zustand nach Bus-Recovery wiederherstellen
+// ----------------------------------------------------
+// Ein Abbruch mitten im Zugriff kann auch ein Control-
+// Register verfälscht haben, daher wird jede Maske neu
+// geschrieben statt dem Cache zu trauen.
+int MuxBank::restore() {
+  uint8_t known = m_known;
+  m_known = 0;
+
+  int res = 0;
+  for (uint8_t m = 0; m < NUM_MUXES; m++) {
+    if (!owns(m)) continue;
+    uint8_t mask = (known & (1 << m)) ? m_mask[m] : 0x00;
+    int r = setMask(m, mask);
+    if (r < 0) res = r;
+    else if (mask) settle(m, mask);
+  }
+  return res;
+}
+
+// ----------------------------------------------------
+// Control-Register zurücklesen
+// ----------------------------------------------------
+uint8_t MuxBank::verify() {
+  uint8_t corrupted = 0;
+
+  for (uint8_t m = 0; m < NUM_MUXES; m++) {
+    if (!(m_known & (1 << m))) continue;
+
+    if (m_wire->requestFrom(MUX_ADDR[m], (uint8_t)1) != 1) {
+      m_known &= ~(1 << m);
+      continue;
+    }
+    uint8_t actual = m_wire->read();
+    if (actual == m_mask[m]) continue;
+
+    // Abweichung: neu schreiben
+    corrupted++;
+    m_corruptions.fetch_add(1, std::memory_order_relaxed);
+    m_known &= ~(1 << m);
+    setMask(m, m_mask[m]);
+  }
+  return corrupted;
+}
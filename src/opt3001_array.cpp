@@ -0,0 +1,1017 @@
+#include "opt3001_array.h"
+
+// ----------------------------------------------------
+// Tabelle aufbauen
+// ----------------------------------------------------
+uint8_t Opt3001Array::begin(TwoWire &wire, uint8_t bus) {
+  m_wire  = &wire;
+  m_bus   = bus;
+  m_count = 0;
+  m_map.clear();
+  m_mux.begin(wire, bus);
+  m_batch.begin((i2c_port_t)bus);   // Bus-Index = I2C-Controller (Wire = 0, Wire1 = 1)
+  m_batched = OPT3001_ARRAY_BATCHED;
+  m_recovery.begin(wire, bus == 0 ? I2C0_SDA : I2C1_SDA, bus == 0 ? I2C0_SCL : I2C1_SCL, I2C_FREQ_HZ);
+
+  uint8_t row = 0;
+  for (uint8_t m = 0; m < NUM_MUXES; m++) {
+    for (uint8_t ch = 0; ch < MUX_CHANNEL_COUNT[m]; ch++) {
+      if (row >= TOTAL_ROWS) break;
+      if (MUX_BUS[m] != bus) {   // Zeile gehört zum anderen Bus
+        row++;
+        continue;
+      }
+
+      for (uint8_t i = 0; i < NUM_SENSORS_PER_CHANNEL; i++) {
+        Opt3001Slot &s = m_slots[m_count];
+        if (s.dev.setup(wire, SENSOR_ADDR[i]) != 0) continue;  // Adresse ungültig
+
+        s.mux      = m;
+        s.channel  = ch;
+        s.addr     = SENSOR_ADDR[i];
+        s.row      = row;
+        s.col      = i;
+        s.mapped   = true;     // bis eine Karte vorliegt
+        s.present  = false;
+        s.pending  = false;
+        s.status   = -ENODEV;
+        s.health   = HEALTH_OK;
+        s.failures = 0;
+        s.backoffMs = 0;
+        s.armed    = false;
+        s.raw      = 0;
+        s.sampleUs = 0;
+        s.dueUs    = 0;
+        s.grid     = GRID_CLEAR;
+        s.unread   = true;
+        s.seen     = 0;
+        s.target   = 1;
+        s.anchorUs = 0;
+        s.resUs    = 0;
+        s.periodUs = 100000;
+        s.slackUs  = 0;
+        s.pollUs   = 0;
+        s.baseUs   = 0;
+        s.baseResUs = 0;
+        s.baseCount = 0;
+        m_count++;
+      }
+      row++;
+    }
+  }
+  return m_count;
+}
+
+// ----------------------------------------------------
+// Sensor-Karte
+// ----------------------------------------------------
+bool Opt3001Array::loadMap() {
+  bool cached = m_map.load(m_bus);
+  if (!cached) {
+    discover(m_map);
+    m_map.store(m_bus);
+  }
+  applyMap();
+  return cached;
+}
+
+// Schnelle Prüfung einer geladenen Karte: configure() hat
+// jeden bestückten Platz ohnehin einmal angesprochen
+bool Opt3001Array::mapConsistent() const {
+  for (uint8_t i = 0; i < m_count; i++) {
+    if (m_slots[i].mapped && !m_slots[i].present) return false;
+  }
+  return true;
+}
+
+void Opt3001Array::rescan() {
+  discover(m_map);
+  m_map.store(m_bus);
+  applyMap();
+  reset();
+  configure(m_ct, true);
+  calibrateSettle();
+}
+
+void Opt3001Array::applyMap() {
+  for (uint8_t i = 0; i < m_count; i++) {
+    Opt3001Slot &s = m_slots[i];
+    s.mapped = m_map.has(s.mux, s.channel, s.addr);
+  }
+}
+
+// ----------------------------------------------------
+// Discovery
+// ----------------------------------------------------
+// Alle TCA9548-Adressen des Busses anpingen (bei offenen
+// Muxen sind keine weiteren aktiv: vorher alle aus), dann
+// je eigenem Mux jeden Kanal einzeln öffnen und die vier
+// möglichen OPT3001-Adressen mit detect() prüfen. Adressen
+// ohne Spalte in SENSOR_ADDR landen nur in der Karte.
+void Opt3001Array::discover(SensorMap &map) {
+  map.clear();
+  m_mux.invalidate();
+  m_mux.disableAll();
+
+  for (uint8_t i = 0; i < 8; i++) {
+    m_wire->beginTransmission(SENSOR_MAP_MUX_BASE + i);
+    if (m_wire->endTransmission() == 0) map.muxAck |= 1 << i;
+  }
+
+  for (uint8_t m = 0; m < NUM_MUXES; m++) {
+    if (!m_mux.owns(m)) continue;
+    if (!(map.muxAck & (1 << (MUX_ADDR[m] - SENSOR_MAP_MUX_BASE)))) continue;   // Mux fehlt
+
+    for (uint8_t ch = 0; ch < MUX_CHANNEL_COUNT[m]; ch++) {
+      if (m_mux.select(m, ch) < 0) continue;
+      for (uint8_t a = 0; a < SENSOR_MAP_ADDR_NUM; a++) {
+        opt3001 dev;
+        if (dev.setup(*m_wire, SENSOR_MAP_ADDR_BASE + a) != 0) continue;
+        if (dev.detect() == 0) map.addrMask[m][ch] |= 1 << a;
+      }
+    }
+  }
+  m_mux.disableAll();
+
+  // Register-Pointer wurden am Treiber der Slots vorbei verstellt
+  for (uint8_t i = 0; i < m_count; i++) m_slots[i].dev.register_pointer_invalidate();
+  map.seal();
+}
+
+// Toleranz des internen Oszillators: Sensor wird nach
+// 90 % der Wandlungszeit wieder fällig
+#define CRF_GUARD_PERCENT 10
+
+// Wandlungs-Raster: ohne CRF gelesen wird nur, solange
+// zwischen spätestem Ende von Wandlung k und frühestem von
+// k + 1 mindestens GRID_WINDOW_PERCENT der Wandlungszeit
+// bleiben (Spielraum für den Aufruf-Takt), und höchstens
+// GRID_SPAN_MAX Wandlungen nach dem Anker. Ohne Messung
+// gilt die Toleranz laut Datenblatt (CRF_GUARD_PERCENT);
+// die Unsicherheit einer gemessenen Periode fällt nicht
+// unter GRID_DRIFT_PERMILLE (Temperatur).
+// GRID_GUARD_US: Zeitstempel vs. Abtastung im Sensor.
+#define GRID_WINDOW_PERCENT 25
+#define GRID_SPAN_MAX       32
+#define GRID_DRIFT_PERMILLE 1
+#define GRID_GUARD_US       500
+
+// ----------------------------------------------------
+// Config-Worte
+// ----------------------------------------------------
+// Alle Felder in einem Wort, geschrieben mit einem Zugriff.
+// Automatischer Messbereich, Latch wie Reset-Default (0xC810)
+static opt3001_config configFor(enum opt3001_conversion_time ct, enum opt3001_mode mode) {
+  return opt3001_config()
+      .range_set(OPT3001_RANGE_AUTO)
+      .conversion_time_set(ct)
+      .mode_set(mode)
+      .latch_set(true);
+}
+
+// ----------------------------------------------------
+// OPT3001 Reset (Config-Register auf 0xC810), per Broadcast
+// ----------------------------------------------------
+void Opt3001Array::reset() {
+  broadcastWrite(OPT3001_REGISTER_CONFIG, opt3001_config().word());
+  delay(5);
+}
+
+// ----------------------------------------------------
+// Continuous Mode per Broadcast, danach je Sensor ein
+// kurzer Zugriff zur Erkennung (optional mit Readback)
+// ----------------------------------------------------
+void Opt3001Array::configure(enum opt3001_conversion_time ct, bool verify) {
+  m_ct           = ct;
+  m_conversionUs = (ct == OPT3001_CONVERSION_TIME_800MS) ? 800000 : 100000;
+  m_snapshot     = false;
+
+  const uint16_t config = configFor(ct, OPT3001_MODE_CONTINUOUS).word();
+  const uint32_t t0     = micros();
+  broadcastWrite(OPT3001_REGISTER_CONFIG, config);
+  const uint32_t t1     = micros();
+
+  for (uint8_t i = 0; i < m_count; i++) {
+    Opt3001Slot &s = m_slots[i];
+    route(s);
+    s.present = false;
+    s.armed   = false;
+    if (!s.mapped) continue;   // leerer Platz: kein NACK-Zyklus
+
+    if (verify) {
+      uint16_t readback;
+      if (s.dev.register_read(OPT3001_REGISTER_CONFIG, &readback) != 0) continue;
+      if ((readback & opt3001_config::WRITABLE) != config) continue;
+    }
+
+    // Pointer auf Result; das ACK zeigt zugleich, dass der Sensor da ist
+    if (s.dev.result_streaming_enable() != 0) continue;
+    s.present = true;
+    s.pending = false;
+    markOk(s);
+
+    // Alle Sensoren haben mit dem Broadcast neu begonnen
+    s.periodUs = m_conversionUs;
+    s.slackUs  = m_conversionUs / 100 * CRF_GUARD_PERCENT;
+    gridRestart(s, t1, t1 - t0);
+  }
+}
+
+// ----------------------------------------------------
+// Hot-Plug
+// ----------------------------------------------------
+// Ein leerer Platz kostet nur einen NACK auf die Adresse
+// (plus ggf. Mux-Umschaltung); reihum über viele Frames
+// verteilt, bis das Budget des Frames verbraucht ist.
+uint8_t Opt3001Array::probeEmpty(uint32_t budgetUs) {
+  const uint32_t t0 = micros();
+  uint8_t added = 0;
+
+  for (uint8_t n = 0; n < m_count && (micros() - t0) < budgetUs; n++) {
+    Opt3001Slot &s = m_slots[m_probeNext];
+    m_probeNext = (m_probeNext + 1) % m_count;
+    if (s.present) continue;
+    if (adopt(s)) added++;
+  }
+
+  if (added) {
+    m_map.seal();
+    m_map.store(m_bus);
+  }
+  return added;
+}
+
+// Erkennen, dann die komplette Config in einem Zugriff
+// (Continuous bzw. Shutdown im Snapshot-Modus, dort setzt der
+// nächste Trigger die Betriebsart), Pointer auf Result.
+bool Opt3001Array::adopt(Opt3001Slot &s) {
+  if (m_mux.select(s.mux, s.channel) < 0) return false;
+  if (s.dev.detect() != 0) return false;
+
+  const enum opt3001_mode mode = m_snapshot ? OPT3001_MODE_SHUTDOWN : OPT3001_MODE_CONTINUOUS;
+  const uint32_t t0 = micros();
+  if (s.dev.config_write(configFor(m_ct, mode)) != 0) return false;
+  const uint32_t t1 = micros();
+  if (s.dev.result_streaming_enable() != 0) return false;
+
+  // Erster Sensor des Kanals: Settle-Zeit an ihm einmessen
+  // (MANUID-Zugriffe verstellen den Pointer)
+  bool first = true;
+  for (uint8_t i = 0; i < m_count; i++) {
+    const Opt3001Slot &o = m_slots[i];
+    if (o.present && o.mux == s.mux && o.channel == s.channel) first = false;
+  }
+  if (first) {
+    calibrateChannel(s);
+    if (s.dev.result_streaming_enable() != 0) return false;
+  }
+
+  s.mapped  = true;
+  s.present = true;
+  s.pending = false;
+  s.armed   = false;
+  s.periodUs = m_conversionUs;
+  s.slackUs  = m_conversionUs / 100 * CRF_GUARD_PERCENT;
+  gridRestart(s, t1, t1 - t0);
+  markOk(s);
+  s.status  = -ENODATA;   // gültig erst mit der ersten Wandlung
+
+  m_map.muxAck |= 1 << (MUX_ADDR[s.mux] - SENSOR_MAP_MUX_BASE);
+  m_map.addrMask[s.mux][s.channel] |= 1 << (s.addr - SENSOR_MAP_ADDR_BASE);
+  m_hotplugged.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+// ----------------------------------------------------
+// Settle-Zeit je Mux-Kanal einmessen
+// ----------------------------------------------------
+// Für jeden Kanal mit erkanntem Sensor wird die Leiter von
+// kurz nach lang probiert: Mux ab, Kanal an, Settle-Zeit,
+// Manufacturer-ID lesen und auf 0x5449 prüfen. Die erste
+// Zeit, bei der alle Versuche fehlerfrei sind, wird im
+// MuxBank gespeichert; sonst bleibt der Default.
+//
+// Leere Kanäle haben keine Gegenstelle. Sie übernehmen den
+// längsten eingemessenen Wert ihres Muxes (gleicher Schalter),
+// ohne Sensor am Mux den längsten des Busses; erst wenn gar
+// nichts eingemessen ist, bleibt der Default. So zahlt die
+// Hot-Plug-Probe nicht je Umschaltung die vollen 500 µs.
+// Ein per Hot-Plug aufgenommener Sensor misst seinen Kanal
+// danach selbst ein (adopt()).
+#define SETTLE_CALIB_TRIALS 8
+
+static const uint16_t SETTLE_LADDER_US[] = { 0, 10, 25, 50, 100, 200, MUX_SETTLE_DEFAULT_US };
+
+void Opt3001Array::calibrateSettle() {
+  uint8_t  calibrated[NUM_MUXES] = {};   // Bit ch: Kanal eingemessen
+  uint16_t muxMax[NUM_MUXES]     = {};
+  uint16_t busMax = 0;
+  bool     any    = false;
+
+  for (uint8_t i = 0; i < m_count; i++) {
+    Opt3001Slot &s = m_slots[i];
+    if (!s.present) continue;
+    if (calibrated[s.mux] & (1 << s.channel)) continue;   // ein Sensor je Kanal reicht
+    calibrated[s.mux] |= 1 << s.channel;
+
+    uint16_t us = calibrateChannel(s);
+    if (us > muxMax[s.mux]) muxMax[s.mux] = us;
+    if (us > busMax) busMax = us;
+    any = true;
+  }
+  if (!any) return;
+
+  for (uint8_t m = 0; m < NUM_MUXES; m++) {
+    if (!m_mux.owns(m)) continue;
+    uint16_t us = calibrated[m] ? muxMax[m] : busMax;
+    for (uint8_t ch = 0; ch < MUX_CHANNEL_COUNT[m]; ch++) {
+      if (!(calibrated[m] & (1 << ch))) m_mux.setSettleUs(m, ch, us);
+    }
+  }
+}
+
+uint16_t Opt3001Array::calibrateChannel(Opt3001Slot &s) {
+  uint16_t chosen = MUX_SETTLE_DEFAULT_US;
+  for (uint8_t t = 0; t < sizeof(SETTLE_LADDER_US) / sizeof(SETTLE_LADDER_US[0]); t++) {
+    m_mux.setSettleUs(s.mux, s.channel, SETTLE_LADDER_US[t]);
+
+    bool ok = true;
+    for (uint8_t n = 0; n < SETTLE_CALIB_TRIALS && ok; n++) {
+      m_mux.disableAll();   // echtes Umschalten erzwingen
+      uint16_t id = 0;
+      ok = m_mux.select(s.mux, s.channel) >= 0 &&
+           s.dev.register_read(OPT3001_REGISTER_MANUID, &id) == 0 &&
+           id == 0x5449;
+    }
+    if (ok) {
+      chosen = SETTLE_LADDER_US[t];
+      break;
+    }
+  }
+  m_mux.setSettleUs(s.mux, s.channel, chosen);
+  return chosen;
+}
+
+// ----------------------------------------------------
+// Betriebsart umschalten (Continuous ↔ Snapshot)
+// ----------------------------------------------------
+void Opt3001Array::setSnapshotMode(bool snapshot) {
+  if (snapshot == m_snapshot) return;
+  m_snapshot = snapshot;
+
+  // Snapshot: Sensoren laufen bis zum nächsten Trigger einfach aus.
+  // Continuous: alle wieder starten, das Raster beginnt mit dem
+  // Broadcast (gemessene Perioden bleiben gültig).
+  uint32_t t0 = micros();
+  if (!snapshot) broadcastWrite(OPT3001_REGISTER_CONFIG, configFor(m_ct, OPT3001_MODE_CONTINUOUS).word());
+  uint32_t t1 = micros();
+
+  for (uint8_t i = 0; i < m_count; i++) {
+    Opt3001Slot &s = m_slots[i];
+    s.pending = false;
+    if (snapshot) continue;
+    const uint32_t backoffUs = s.dueUs;
+    gridRestart(s, t1, t1 - t0);
+    if (s.health == HEALTH_FAILED) s.dueUs = backoffUs;   // Backoff bleibt
+  }
+}
+
+// ----------------------------------------------------
+// Snapshot: Single-Shot-Trigger an alle Sensoren
+// ----------------------------------------------------
+// Alle Muxe werden gleichzeitig mit allen Kanälen
+// geöffnet, dann geht je Sensoradresse ein Schreibzugriff
+// raus: alle Sensoren einer Spalte starten exakt
+// gleichzeitig, die drei Spalten im Abstand eines
+// Schreibzugriffs (~0.3 ms bei 100 kHz).
+uint32_t Opt3001Array::triggerSnapshot() {
+  const uint16_t config    = configFor(m_ct, OPT3001_MODE_SINGLESHOT).word();
+  const uint32_t holdoffUs = m_conversionUs / 100 * (100 - CRF_GUARD_PERCENT);
+
+  m_mux.openAll();
+
+  uint32_t triggerUs = micros();
+  for (uint8_t i = 0; i < NUM_SENSORS_PER_CHANNEL; i++) {
+    m_wire->beginTransmission(SENSOR_ADDR[i]);
+    m_wire->write(OPT3001_REGISTER_CONFIG);
+    m_wire->write((uint8_t)(config >> 8));
+    m_wire->write((uint8_t)(config >> 0));
+    m_wire->endTransmission();
+  }
+
+  m_mux.disableAll();
+
+  for (uint8_t i = 0; i < m_count; i++) {
+    Opt3001Slot &s = m_slots[i];
+    s.dev.register_pointer_invalidate();
+    s.dev.config_shadow_invalidate();
+    if (s.health == HEALTH_FAILED) continue;   // nur Probes mit Backoff
+    s.pending = s.present;
+    s.dueUs   = triggerUs + holdoffUs;
+  }
+  return triggerUs;
+}
+
+bool Opt3001Array::snapshotComplete() const {
+  for (uint8_t i = 0; i < m_count; i++) {
+    if (m_slots[i].pending) return false;
+  }
+  return true;
+}
+
+// Sensoren ohne Ergebnis bis zum Timeout als ungültig markieren
+void Opt3001Array::abortSnapshot() {
+  uint32_t now = micros();
+  for (uint8_t i = 0; i < m_count; i++) {
+    Opt3001Slot &s = m_slots[i];
+    if (!s.pending) continue;
+    markFailed(s, -ETIMEDOUT, now);
+  }
+}
+
+// ----------------------------------------------------
+// Broadcast: alle Kanäle eines Muxes gleichzeitig
+// ----------------------------------------------------
+// Hinter einem Mux teilen sich alle Kanäle dieselben
+// SENSOR_ADDR. Sind alle Kanäle aktiv, quittieren alle
+// Sensoren einer Adresse gemeinsam (Wired-AND) und ein
+// Schreibzugriff erreicht bis zu 8 Sensoren auf einmal.
+// Lesen ist so nicht möglich (Kollision).
+uint8_t Opt3001Array::broadcastWrite(enum opt3001_register reg, uint16_t value) {
+  uint8_t acked = 0;
+
+  for (uint8_t m = 0; m < NUM_MUXES; m++) {
+    if (!m_mux.owns(m)) continue;
+    m_mux.selectMask(m, (1 << MUX_CHANNEL_COUNT[m]) - 1);
+
+    for (uint8_t i = 0; i < NUM_SENSORS_PER_CHANNEL; i++) {
+      m_wire->beginTransmission(SENSOR_ADDR[i]);
+      m_wire->write(reg);
+      m_wire->write((uint8_t)(value >> 8));
+      m_wire->write((uint8_t)(value >> 0));
+      if (m_wire->endTransmission() == 0) acked++;
+    }
+  }
+  m_mux.disableAll();
+
+  // Register-Pointer (und ggf. Config) aller Sensoren wurden am
+  // Treiber vorbei verstellt
+  for (uint8_t i = 0; i < m_count; i++) {
+    m_slots[i].dev.register_pointer_invalidate();
+    if (reg == OPT3001_REGISTER_CONFIG) m_slots[i].dev.config_shadow_invalidate();
+  }
+  return acked;
+}
+
+// ----------------------------------------------------
+// Durchlauf nach Wandlungs-Raster
+// ----------------------------------------------------
+// Ein Sensor mit festem Raster (GRID_LOCKED) wird kurz
+// nach dem vorhergesagten Ende seiner Wandlung fällig und
+// kostet dann nur den 2-Byte-Read des Results: der Pointer
+// steht seit dem letzten Result dort (Streaming-Modus des
+// Treibers). Sonst wird vor der erwarteten Wandlung das
+// CRF gelöscht (GRID_CLEAR) und danach je Aufruf abgefragt
+// (GRID_POLL); das Setzen verankert das Raster neu. Im
+// Snapshot-Modus wird nach dem Trigger CRF-gesteuert
+// gelesen, nur Sensoren mit offenem Trigger ('pending').
+//
+// Die Tabelle ist nach Kanal sortiert; jeder Kanal wird
+// gebündelt (serviceBatch) oder, als Fallback, Sensor für
+// Sensor über Wire abgearbeitet. Nicht gesunde Sensoren
+// laufen immer einzeln (siehe SensorHealth).
+void Opt3001Array::service(uint32_t nowUs) {
+  m_passErrors = 0;
+  uint8_t first = 0;
+  while (first < m_count) {
+    uint8_t end = first + 1;
+    while (end < m_count &&
+           m_slots[end].mux     == m_slots[first].mux &&
+           m_slots[end].channel == m_slots[first].channel) end++;
+
+    int batch = m_batched ? serviceBatch(first, end, nowUs) : -ENOTSUP;
+    // Hängt der Bus, würde jeder Einzelzugriff bis zum Timeout laufen
+    if (batch == -EIO && !m_recovery.linesIdle()) recoverBus();
+
+    bool all = batch != 0;
+    for (uint8_t i = first; i < end; i++) {
+      if (all || m_slots[i].health != HEALTH_OK) serviceSlot(m_slots[i], nowUs);
+    }
+    first = end;
+  }
+
+  if (m_mux.takeBusFault() || (m_passErrors && !m_recovery.linesIdle())) recoverBus();
+}
+
+bool Opt3001Array::isDue(const Opt3001Slot &s, uint32_t nowUs) const {
+  if (!s.present) return false;
+  if (s.health == HEALTH_FAILED) return (int32_t)(nowUs - s.dueUs) >= 0;   // Probe, auch im Snapshot
+  if (m_snapshot && !s.pending) return false;
+  return (int32_t)(nowUs - s.dueUs) >= 0;
+}
+
+void Opt3001Array::serviceSlot(Opt3001Slot &s, uint32_t nowUs) {
+  if (!isDue(s, nowUs)) return;
+  if (s.health == HEALTH_FAILED) {
+    probe(s, nowUs);
+    return;
+  }
+
+  bool switched = route(s);
+
+  const bool locked = gridLocked(s);
+  const uint32_t t0 = micros();
+  uint16_t value;
+  if (s.dev.register_read(locked ? OPT3001_REGISTER_RESULT : OPT3001_REGISTER_CONFIG, &value) != 0) {
+    // NACK direkt nach Umschalten: Settle-Zeit, aber nur bei bisher
+    // gesunden Sensoren (ein toter Sensor soll den Kanal nicht bremsen)
+    if (switched && s.health == HEALTH_OK) m_mux.bumpSettle(s.mux, s.channel);
+    markFailed(s, -EIO, nowUs);
+    return;
+  }
+  const uint32_t t1 = micros();
+  if (switched) m_mux.settleOk(s.mux, s.channel);
+  if (locked) {
+    gridResult(s, value, t0, t1);
+    return;
+  }
+
+  if (windowed(s)) {
+    windowCheck(s, value, nowUs);
+    return;
+  }
+  const bool ready = m_snapshot ? opt3001::conversion_ready_from_config(value)
+                                : gridConfig(s, value, t0, t1);
+  s.unread = true;   // Config gelesen: CRF gelöscht
+  if (!ready) return;   // bleibt fällig bzw. Raster geplant
+
+  uint16_t raw;
+  if (s.dev.register_read(OPT3001_REGISTER_RESULT, &raw) == 0) {
+    sampled(s, raw, micros());
+  } else {
+    markFailed(s, -EIO, nowUs);
+  }
+}
+
+void Opt3001Array::sampled(Opt3001Slot &s, uint16_t raw, uint32_t sampleUs) {
+  s.raw      = raw;
+  s.sampleUs = sampleUs;
+  s.pending  = false;
+  markOk(s);
+  if (m_window && !m_snapshot) arm(s);
+}
+
+// ----------------------------------------------------
+// Wandlungs-Raster
+// ----------------------------------------------------
+// Wandlung k (gezählt ab dem Anker) endet bei
+// anchorUs + k * periodUs, mit der Unsicherheit des Ankers
+// (resUs, nur nach vorn) und k * slackUs aus der Periode.
+// Ein Result-Read ab dem spätesten Ende von k und vor dem
+// frühesten Ende von k + 1 liest sicher Wandlung k.
+//
+// Verankert wird mit dem CRF: die Config wird vor dem
+// frühesten Ende gelesen (löscht das CRF) und danach je
+// Aufruf, bis das CRF gesetzt ist; die Wandlung endete
+// zwischen den beiden letzten Abfragen (geschnitten mit der
+// Vorhersage). Der Abstand zur Basis (Neustart bzw.
+// schärfster Anker) über alle Wandlungen dazwischen grenzt
+// die Periode ein; mit jedem Anker sinkt so die
+// Unsicherheit und der Abstand der Anker wächst von selbst
+// bis GRID_SPAN_MAX. Trifft ein Result-Read die Unschärfe
+// zwischen zwei Wandlungen (später Aufruf), wird ebenfalls
+// neu verankert.
+uint32_t Opt3001Array::gridSlackUs(const Opt3001Slot &s, uint32_t k) const {
+  return s.resUs + k * s.slackUs + GRID_GUARD_US;
+}
+
+uint32_t Opt3001Array::gridDone(const Opt3001Slot &s, uint32_t tUs) const {
+  // anchorUs + k * (periodUs + slackUs) + resUs + Guard <= tUs
+  const int32_t d = (int32_t)(tUs - s.anchorUs) - (int32_t)(s.resUs + GRID_GUARD_US);
+  return d > 0 ? (uint32_t)d / (s.periodUs + s.slackUs) : 0;
+}
+
+uint32_t Opt3001Array::gridMaybe(const Opt3001Slot &s, uint32_t tUs) const {
+  // anchorUs + k * (periodUs - slackUs) - resUs - Guard <= tUs
+  const int32_t d = (int32_t)(tUs - s.anchorUs) + (int32_t)(s.resUs + GRID_GUARD_US);
+  return d > 0 ? (uint32_t)d / (s.periodUs - s.slackUs) : 0;
+}
+
+void Opt3001Array::gridRestart(Opt3001Slot &s, uint32_t startUs, uint32_t resUs) {
+  s.anchorUs = startUs;
+  s.resUs    = resUs;
+  s.baseUs   = startUs - resUs / 2;
+  s.baseResUs = resUs;
+  s.baseCount = 0;
+  s.seen     = 0;
+  s.unread   = true;   // Config geschrieben: CRF gelöscht
+  gridSchedule(s, 1);
+}
+
+void Opt3001Array::gridSchedule(Opt3001Slot &s, uint32_t k) {
+  s.target = k;
+  if (k <= GRID_SPAN_MAX &&
+      gridSlackUs(s, k) + gridSlackUs(s, k + 1) <= s.periodUs / 100 * (100 - GRID_WINDOW_PERCENT)) {
+    s.grid  = GRID_LOCKED;
+    s.dueUs = gridEdgeUs(s, k) + gridSlackUs(s, k);
+  } else {
+    s.grid  = GRID_CLEAR;
+    s.dueUs = gridEdgeUs(s, k) - gridSlackUs(s, k);
+  }
+}
+
+void Opt3001Array::gridResult(Opt3001Slot &s, uint16_t raw, uint32_t t0Us, uint32_t t1Us) {
+  sampled(s, raw, t1Us);
+  s.unread = false;   // CRF dieser Wandlung bleibt gesetzt
+
+  const uint32_t done = gridDone(s, t0Us);
+  const uint32_t maybe = gridMaybe(s, t1Us);
+  if (maybe != done) {
+    // Wandlung 'done' oder 'maybe' gelesen: nächste am CRF abwarten
+    s.seen   = maybe;
+    s.target = maybe + 1;
+    s.grid   = GRID_CLEAR;
+    s.dueUs  = t1Us;
+    return;
+  }
+  s.seen = done;
+  gridSchedule(s, done + rowConversions(s));
+}
+
+bool Opt3001Array::gridConfig(Opt3001Slot &s, uint16_t config, uint32_t t0Us, uint32_t t1Us) {
+  const bool crf = opt3001::conversion_ready_from_config(config);
+
+  if (s.grid == GRID_POLL && crf) {
+    // Wandlung endete in (pollUs, t1Us], geschnitten mit der
+    // Vorhersage, falls die Nummer c der Wandlung eindeutig ist
+    uint32_t loUs = s.pollUs;
+    uint32_t hiUs = t1Us;
+    const uint32_t lastUs = s.anchorUs - s.resUs / 2;
+    const uint32_t c = (hiUs - (hiUs - loUs) / 2 - lastUs + s.periodUs / 2) / s.periodUs;
+    bool fit = c > 0 && (s.resUs + (hiUs - loUs)) / 2 + c * s.slackUs < s.periodUs / 2;
+    if (fit) {
+      const uint32_t predLoUs = gridEdgeUs(s, c) - gridSlackUs(s, c);
+      const uint32_t predHiUs = gridEdgeUs(s, c) + c * s.slackUs + GRID_GUARD_US;
+      if ((int32_t)(predHiUs - loUs) > 0 && (int32_t)(hiUs - predLoUs) > 0) {
+        if ((int32_t)(predLoUs - loUs) > 0) loUs = predLoUs;
+        if ((int32_t)(predHiUs - hiUs) < 0) hiUs = predHiUs;
+      } else {
+        // Schranke verletzt (Drift): Unsicherheit erhöhen
+        fit = false;
+        s.slackUs = s.slackUs * 2 > s.periodUs / 4 ? s.periodUs / 4 : s.slackUs * 2;
+      }
+    }
+
+    // Periode: Bereich aus Basis (Neustart bzw. schärfster Anker)
+    // und diesem Anker mit dem bisherigen schneiden; bei Drift
+    // gilt der neue Bereich allein
+    const uint32_t resUs = hiUs - loUs;
+    if (fit) {
+      s.baseCount += c;
+      const uint32_t minUs = s.periodUs / 1000 * GRID_DRIFT_PERMILLE;
+      const uint32_t baseLoUs = s.baseUs - s.baseResUs / 2;
+      const uint32_t baseHiUs = baseLoUs + s.baseResUs;
+      uint32_t shortUs = (loUs - baseHiUs) / s.baseCount;
+      uint32_t longUs  = (hiUs - baseLoUs) / s.baseCount;
+      if (shortUs < s.periodUs + s.slackUs && longUs > s.periodUs - s.slackUs) {
+        if (shortUs < s.periodUs - s.slackUs) shortUs = s.periodUs - s.slackUs;
+        if (longUs > s.periodUs + s.slackUs) longUs = s.periodUs + s.slackUs;
+      }
+      s.periodUs = (shortUs + longUs) / 2;
+      s.slackUs  = (longUs - shortUs) / 2 > minUs ? (longUs - shortUs) / 2 : minUs;
+    }
+    if (!fit || resUs < s.baseResUs) {
+      s.baseUs    = hiUs - resUs / 2;
+      s.baseResUs = resUs;
+      s.baseCount = 0;
+    }
+
+    s.anchorUs = hiUs;
+    s.resUs    = resUs;
+    s.seen     = 0;
+    gridSchedule(s, rowConversions(s));
+    return true;   // Wandlung 0 des neuen Ankers
+  }
+
+  // Lesen, wenn das gesetzte CRF sicher eine neue Wandlung ist
+  // (CRF nach Ende der zuletzt gelesenen Wandlung gelöscht, oder
+  // eine spätere als die gelesene sicher fertig)
+  const bool fresh = crf && (s.unread || gridDone(s, t0Us) > s.seen);
+  if (fresh) s.seen = gridMaybe(s, t1Us);
+
+  // Config löscht das CRF; die Zielwandlung ab jetzt abfragen
+  // bzw., wenn sie sicher schon fertig ist, die nächste
+  if (gridDone(s, t0Us) >= s.target) s.target = gridMaybe(s, t1Us) + 1;
+  s.grid   = GRID_POLL;
+  s.pollUs = t0Us;
+  const uint32_t fromUs = gridEdgeUs(s, s.target) - gridSlackUs(s, s.target);
+  s.dueUs = (int32_t)(fromUs - t1Us) > 0 ? fromUs : t1Us;
+  return fresh;
+}
+
+// ----------------------------------------------------
+// Zeilenplan
+// ----------------------------------------------------
+// Ruhige Zeilen lesen im Raster erst die n-te Wandlung
+// nach der gelesenen. Neu aktive Zeilen werden auf die
+// nächste Wandlung umgeplant (im Raster bzw. vor der CRF-
+// Abfrage); Fenster und Snapshot bleiben CRF-gesteuert.
+void Opt3001Array::setRowSchedule(uint32_t hotRows, uint16_t maxStaleMs) {
+  if (hotRows == m_hotRows && maxStaleMs == m_maxStaleMs) return;
+
+  uint32_t n = (uint32_t)maxStaleMs * 1000 / m_conversionUs;
+  if (n > FOVEA_COLD_CONVERSIONS) n = FOVEA_COLD_CONVERSIONS;
+  if (n < 1) n = 1;
+  m_coldConversions = n;
+  m_maxStaleMs      = maxStaleMs;
+
+  // Neu aktive Zeilen nicht erst nach dem langen Abstand bedienen
+  const uint32_t woken = hotRows & ~m_hotRows;
+  m_hotRows = hotRows;
+
+  const uint32_t now = micros();
+  for (uint8_t i = 0; i < m_count; i++) {
+    Opt3001Slot &s = m_slots[i];
+    if (!((woken >> s.row) & 1) || s.health == HEALTH_FAILED) continue;
+    if (m_snapshot || windowed(s)) {
+      if ((int32_t)(s.dueUs - now) > 0) s.dueUs = now;
+    } else if (s.grid != GRID_POLL && s.target > s.seen + 1) {
+      gridSchedule(s, s.seen + 1);
+    }
+  }
+}
+
+// ----------------------------------------------------
+// Fenster-Modus
+// ----------------------------------------------------
+void Opt3001Array::setWindowMode(bool window) {
+  if (window == m_window) return;
+  m_window = window;
+
+  // Beim Einschalten liest jeder Sensor erst einen Wert im Raster
+  // und setzt damit seine Grenzen. Beim Ausschalten ist das Raster
+  // veraltet (nur Flags gelesen): am CRF neu verankern.
+  for (uint8_t i = 0; i < m_count; i++) {
+    m_slots[i].armed = false;
+    if (!window) m_slots[i].grid = GRID_CLEAR;
+  }
+}
+
+void Opt3001Array::arm(Opt3001Slot &s) {
+  uint32_t centilux = opt3001::centilux_from_raw(s.raw);
+  uint32_t band     = centilux / 100 * WINDOW_PERCENT;
+  if (band < WINDOW_MIN_CENTILUX) band = WINDOW_MIN_CENTILUX;
+
+  uint32_t low = centilux > band ? centilux - band : 0;
+  s.armed = s.dev.limits_set(low, centilux + band) == 0;   // sonst nächster Wert über CRF
+}
+
+void Opt3001Array::windowCheck(Opt3001Slot &s, uint16_t config, uint32_t nowUs) {
+  m_windowChecks.fetch_add(1, std::memory_order_relaxed);
+  s.unread = true;
+  s.dueUs = nowUs + m_conversionUs * rowConversions(s);   // Flags halten bis zur Prüfung
+
+  if (!opt3001::limit_exceeded_from_config(config)) {
+    s.sampleUs = nowUs;   // alle Wandlungen seit der letzten Prüfung im Fenster
+    markOk(s);
+    return;
+  }
+
+  // Fenster verlassen: aktuellen Wert lesen, Grenzen nachführen
+  m_windowReads.fetch_add(1, std::memory_order_relaxed);
+  uint16_t raw;
+  if (s.dev.register_read(OPT3001_REGISTER_RESULT, &raw) != 0) {
+    markFailed(s, -EIO, nowUs);
+    return;
+  }
+  s.raw      = raw;
+  s.sampleUs = micros();
+  markOk(s);
+  arm(s);
+}
+
+// ----------------------------------------------------
+// Health-Übergänge
+// ----------------------------------------------------
+void Opt3001Array::markOk(Opt3001Slot &s) {
+  s.status    = 0;
+  s.health    = HEALTH_OK;
+  s.failures  = 0;
+  s.backoffMs = 0;
+}
+
+// Fehler zählen; ab HEALTH_SUSPECT_LIMIT in Folge (oder bei
+// fehlgeschlagener Probe) nur noch Probes mit wachsendem Abstand
+void Opt3001Array::markFailed(Opt3001Slot &s, int8_t err, uint32_t nowUs) {
+  if (m_passErrors < 0xFF) m_passErrors++;
+  s.status  = err;
+  s.pending = false;
+  s.grid    = GRID_CLEAR;   // danach am CRF neu verankern
+  if (s.failures < 0xFF) s.failures++;
+
+  if (s.health == HEALTH_PROBING) {
+    uint32_t next = (uint32_t)s.backoffMs * 2;
+    s.backoffMs = next > HEALTH_BACKOFF_MAX_MS ? HEALTH_BACKOFF_MAX_MS : next;
+    s.health    = HEALTH_FAILED;
+  } else if (s.failures >= HEALTH_SUSPECT_LIMIT) {
+    // backoffMs != 0: nach erfolgreicher Probe gleich wieder ausgefallen,
+    // Abstand weiter verdoppeln statt von vorn beginnen
+    uint32_t next = s.backoffMs ? (uint32_t)s.backoffMs * 2 : HEALTH_BACKOFF_MIN_MS;
+    s.backoffMs = next > HEALTH_BACKOFF_MAX_MS ? HEALTH_BACKOFF_MAX_MS : next;
+    s.health    = HEALTH_FAILED;
+  } else {
+    s.health = HEALTH_SUSPECT;
+    s.dueUs  = nowUs + m_conversionUs;  // fehlerhafte Sensoren nicht jeden Tick
+    return;
+  }
+  s.dueUs = nowUs + (uint32_t)s.backoffMs * 1000;
+}
+
+// ----------------------------------------------------
+// Probe eines ausgefallenen Sensors
+// ----------------------------------------------------
+// Ein Zugriff auf das Config-Register. Antwortet der Sensor
+// wieder, war er evtl. stromlos (Reset-Default = Shutdown):
+// im Continuous-Modus wird die Config dann neu geschrieben.
+// Im Snapshot-Modus setzt der nächste Trigger die Config.
+void Opt3001Array::probe(Opt3001Slot &s, uint32_t nowUs) {
+  s.health = HEALTH_PROBING;
+  route(s);
+
+  uint16_t config;
+  if (s.dev.register_read(OPT3001_REGISTER_CONFIG, &config) != 0) {
+    markFailed(s, s.status, nowUs);
+    return;
+  }
+
+  s.unread = true;
+  s.dueUs  = nowUs;   // CRF gleich wieder abfragen (GRID_CLEAR)
+  if (!m_snapshot) {
+    const opt3001_config expected = configFor(m_ct, OPT3001_MODE_CONTINUOUS);
+    if ((config & opt3001_config::WRITABLE) != expected.word()) {
+      const uint32_t t0 = micros();
+      if (s.dev.config_write(expected) != 0) {
+        markFailed(s, s.status, nowUs);
+        return;
+      }
+      const uint32_t t1 = micros();
+      gridRestart(s, t1, t1 - t0);   // Wandlung beginnt neu
+    }
+  }
+
+  // Wieder im normalen Zyklus; der alte Wert bleibt bis zur
+  // nächsten Wandlung ungültig
+  s.health   = HEALTH_SUSPECT;
+  s.failures = 0;
+  s.armed    = false;   // Limits evtl. mit dem Reset verloren
+  s.pending  = false;
+}
+
+// ----------------------------------------------------
+// Ein Kanal in höchstens drei Transaktionen
+// ----------------------------------------------------
+// Beim Kanalwechsel zuerst die Mux-Auswahl als eigene
+// Transaktion: der TCA9548A schaltet eine neue Maske erst
+// mit dem STOP durch, ein Repeated Start danach erreicht
+// noch den alten Kanal (und dort Sensoren mit denselben
+// Adressen). Alle Mux-Schreibzugriffe teilen sich den
+// einen STOP, das neue Routing gilt also auf einmal.
+// Dann je fälligem Sensor ein Register: im Raster das
+// Result (Pointer steht dort, 2-Byte-Read), sonst die
+// Config (CRF bzw. Fenster-Flags). Zuletzt, nur wenn
+// nötig: Result der Sensoren, deren Config eine neue
+// Wandlung zeigt. Config vor Result: ist das CRF gesetzt,
+// ist das danach gelesene Result mindestens diese Wandlung.
+//
+// Braucht der Kanal eine Settle-Zeit, wird der Mux vorher
+// über MuxBank umgeschaltet (Wartezeit lässt sich nicht in
+// den Command-Link legen). Schlägt eine Transaktion fehl,
+// übernimmt der Wire-Pfad den Kanal und ordnet Fehler und
+// Settle-Anpassung dem einzelnen Sensor zu; ein bereits
+// gelöschtes CRF kostet dabei höchstens eine Wandlung.
+// Im Fenster-Modus wird für überwachte Sensoren nur die
+// Config gelesen.
+int Opt3001Array::serviceBatch(uint8_t first, uint8_t end, uint32_t nowUs) {
+  uint8_t due[NUM_SENSORS_PER_CHANNEL];
+  uint8_t numDue = 0;
+  for (uint8_t i = first; i < end && numDue < NUM_SENSORS_PER_CHANNEL; i++) {
+    if (m_slots[i].health == HEALTH_OK && isDue(m_slots[i], nowUs)) due[numDue++] = i;
+  }
+  if (numDue == 0) return 0;
+
+  const Opt3001Slot &head = m_slots[first];
+  MuxWrite muxWrites[NUM_MUXES];
+  uint8_t  numMux = 0;
+  int      switched = 0;
+  if (m_mux.settleUs(head.mux, head.channel) == 0) {
+    numMux = m_mux.planSelect(head.mux, head.channel, muxWrites);
+  } else if ((switched = m_mux.select(head.mux, head.channel)) < 0) {
+    return -EIO;
+  }
+
+  int res;
+  if (numMux) {
+    m_batch.clear();
+    for (uint8_t k = 0; k < numMux; k++) m_batch.writeByte(muxWrites[k].addr, muxWrites[k].mask);
+    res = m_batch.execute();
+    m_mux.applySelect(head.mux, head.channel, res == 0);
+    if (res == -ENOTSUP) m_batched = false;   // Port ohne IDF-Treiber: dauerhaft Wire
+    if (res != 0) return res;
+    switched = 1;
+  }
+
+  // --- 1. Result (Raster) bzw. Config aller fälligen Sensoren ---
+  uint8_t  value[NUM_SENSORS_PER_CHANNEL][2];
+  bool     locked[NUM_SENSORS_PER_CHANNEL];
+  m_batch.clear();
+  for (uint8_t k = 0; k < numDue; k++) {
+    Opt3001Slot &s = m_slots[due[k]];
+    locked[k] = gridLocked(s);
+    const enum opt3001_register reg = locked[k] ? OPT3001_REGISTER_RESULT : OPT3001_REGISTER_CONFIG;
+    m_batch.readRegister(s.addr, reg, value[k], s.dev.register_read_pointer_required(reg));
+  }
+  const uint32_t t0 = micros();
+  res = m_batch.execute();
+  const uint32_t t1 = micros();
+
+  if (res == -ENOTSUP) m_batched = false;   // Port ohne IDF-Treiber: dauerhaft Wire
+  if (res != 0) {
+    for (uint8_t k = 0; k < numDue; k++) m_slots[due[k]].dev.register_pointer_invalidate();
+    return res;
+  }
+  if (switched > 0) m_mux.settleOk(head.mux, head.channel);
+
+  uint8_t ready[NUM_SENSORS_PER_CHANNEL];   // Index in 'due': Result jetzt lesen
+  uint8_t numReady = 0;
+  for (uint8_t k = 0; k < numDue; k++) {
+    Opt3001Slot &s = m_slots[due[k]];
+    if (locked[k]) {
+      uint16_t raw;
+      s.dev.register_read_complete(OPT3001_REGISTER_RESULT, value[k], &raw);
+      gridResult(s, raw, t0, t1);
+      continue;
+    }
+
+    uint16_t reg_config;
+    s.dev.register_read_complete(OPT3001_REGISTER_CONFIG, value[k], &reg_config);
+    if (windowed(s)) {
+      windowCheck(s, reg_config, nowUs);   // Result ggf. einzeln über Wire
+      continue;
+    }
+    const bool now = m_snapshot ? opt3001::conversion_ready_from_config(reg_config)
+                                : gridConfig(s, reg_config, t0, t1);
+    s.unread = true;   // Config gelesen: CRF gelöscht
+    if (now) ready[numReady++] = k;   // sonst bleibt fällig bzw. Raster geplant
+  }
+  if (numReady == 0) return 0;
+
+  // --- 2. Result der Sensoren mit neuer Wandlung (Mux steht noch) ---
+  uint8_t result[NUM_SENSORS_PER_CHANNEL][2];
+  m_batch.clear();
+  for (uint8_t j = 0; j < numReady; j++) {
+    Opt3001Slot &s = m_slots[due[ready[j]]];
+    m_batch.readRegister(s.addr, OPT3001_REGISTER_RESULT, result[j],
+                         s.dev.register_read_pointer_required(OPT3001_REGISTER_RESULT));
+  }
+  res = m_batch.execute();
+  if (res != 0) {
+    for (uint8_t j = 0; j < numReady; j++) m_slots[due[ready[j]]].dev.register_pointer_invalidate();
+    return res;
+  }
+
+  const uint32_t sampleUs = micros();
+  for (uint8_t j = 0; j < numReady; j++) {
+    Opt3001Slot &s = m_slots[due[ready[j]]];
+    uint16_t raw;
+    s.dev.register_read_complete(OPT3001_REGISTER_RESULT, result[j], &raw);
+    sampled(s, raw, sampleUs);
+  }
+  return 0;
+}
+
+// ----------------------------------------------------
+// Bus-Recovery
+// ----------------------------------------------------
+// Nach dem Neustart von Wire sind Mux-Masken und Sensor-
+// Pointer unsicher: Muxe werden aus dem Cache neu
+// geschrieben, alle Pointer verworfen.
+int Opt3001Array::recoverBus() {
+  int res = m_recovery.recover();
+  m_mux.takeBusFault();
+  m_mux.restore();
+  for (uint8_t i = 0; i < m_count; i++) m_slots[i].dev.register_pointer_invalidate();
+  return res;
+}
+
+uint16_t Opt3001Array::sampleAgeMs(const Opt3001Slot &s, uint32_t nowUs) const {
+  if (s.status != 0) return 0xFFFF;
+  uint32_t age = (nowUs - s.sampleUs) / 1000;
+  return age > 0xFFFE ? 0xFFFE : age;
+}
+
+// ----------------------------------------------------
+// Mux-Routing (MuxBank überspringt redundante Schreibzugriffe)
+// ----------------------------------------------------
+bool Opt3001Array::route(const Opt3001Slot &s) {
+  return m_mux.select(s.mux, s.channel) > 0;
+}
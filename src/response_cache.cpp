@@ -0,0 +1,25 @@
+#include "response_cache.h"
+
+const CachedResponse *ResponseCache::find(uint8_t format, uint32_t seq) {
+  const CachedResponse &e = m_entries[format];
+  if (e.valid && e.seq == seq) {
+    m_hits++;
+    return &e;
+  }
+  m_misses++;
+  return NULL;
+}
+
+char *ResponseCache::begin(uint8_t format) {
+  CachedResponse &e = m_entries[format];
+  e.valid = false;
+  return e.data;
+}
+
+const CachedResponse *ResponseCache::commit(uint8_t format, uint32_t seq, size_t length) {
+  CachedResponse &e = m_entries[format];
+  e.seq    = seq;
+  e.length = length;
+  e.valid  = true;
+  return &e;
+}
@@ -0,0 +1,65 @@
+#include "sensor_map.h"
+
+#include <Preferences.h>
+
+void SensorMap::clear() {
+  version = 0;
+  muxAck  = 0;
+  memset(addrMask, 0, sizeof(addrMask));
+  hash    = 0;
+}
+
+// ----------------------------------------------------
+// FNV-1a über Karte und Topologie-Konstanten
+// ----------------------------------------------------
+static uint32_t fnv1a(uint32_t h, const uint8_t *data, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    h ^= data[i];
+    h *= 16777619UL;
+  }
+  return h;
+}
+
+uint32_t SensorMap::computeHash() const {
+  uint32_t h = 2166136261UL;
+  h = fnv1a(h, &version, 1);
+  h = fnv1a(h, &muxAck, 1);
+  h = fnv1a(h, &addrMask[0][0], sizeof(addrMask));
+
+  h = fnv1a(h, MUX_ADDR, sizeof(MUX_ADDR));
+  h = fnv1a(h, MUX_CHANNEL_COUNT, sizeof(MUX_CHANNEL_COUNT));
+  h = fnv1a(h, MUX_BUS, sizeof(MUX_BUS));
+  h = fnv1a(h, SENSOR_ADDR, sizeof(SENSOR_ADDR));
+  return h;
+}
+
+// ----------------------------------------------------
+// NVS
+// ----------------------------------------------------
+static void mapKey(char key[8], uint8_t bus) {
+  snprintf(key, 8, "bus%u", bus);
+}
+
+bool SensorMap::load(uint8_t bus) {
+  char key[8];
+  mapKey(key, bus);
+
+  Preferences prefs;
+  if (!prefs.begin(SENSOR_MAP_NAMESPACE, true)) return false;
+  bool ok = prefs.getBytesLength(key) == sizeof(*this) &&
+            prefs.getBytes(key, this, sizeof(*this)) == sizeof(*this);
+  prefs.end();
+
+  return ok && valid();
+}
+
+bool SensorMap::store(uint8_t bus) const {
+  char key[8];
+  mapKey(key, bus);
+
+  Preferences prefs;
+  if (!prefs.begin(SENSOR_MAP_NAMESPACE, false)) return false;
+  bool ok = prefs.putBytes(key, this, sizeof(*this)) == sizeof(*this);
+  prefs.end();
+  return ok;
+}
@@ -0,0 +1,89 @@
+#include "Arduino.h"
+#include "sim_bus.h"
+
+// ----------------------------------------------------
+// Pins
+// ----------------------------------------------------
+// Ein Pin gehört zum Bus, dessen SDA/SCL er ist. Treiben
+// kann ihn nur ein Ausgang und nur, solange der I2C-
+// Treiber die Pins abgegeben hat (TwoWire::end()).
+static uint8_t s_mode[64];
+
+// OUTPUT und OUTPUT_OPEN_DRAIN haben Bit 1 gesetzt
+static bool isOutput(uint8_t pin) {
+  return pin < sizeof(s_mode) && (s_mode[pin] & 0x02);
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  if (pin < sizeof(s_mode)) s_mode[pin] = mode;
+  if (!isOutput(pin)) digitalWrite(pin, HIGH);   // Eingang: Leitung loslassen
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+  bool low = isOutput(pin) && val == LOW;
+  for (uint8_t port = 0; port < 2; port++) {
+    SimBus &b = sim::bus(port);
+    if (b.driver()) continue;
+    if (pin == b.sdaPin()) b.driveSda(low);
+    if (pin == b.sclPin()) b.driveScl(low);
+  }
+}
+
+int digitalRead(uint8_t pin) {
+  for (uint8_t port = 0; port < 2; port++) {
+    SimBus &b = sim::bus(port);
+    if (pin == b.sdaPin()) return b.sdaLevel() ? HIGH : LOW;
+    if (pin == b.sclPin()) return b.sclLevel() ? HIGH : LOW;
+  }
+  return HIGH;
+}
+
+// ----------------------------------------------------
+// dtostrf (stdlib_noniso.c des Kerns)
+// ----------------------------------------------------
+// Bewusst dieselbe Rechnung in double wie auf dem Gerät:
+// die Tests vergleichen JsonWriter::formatLux() damit.
+char *dtostrf(double number, signed char width, unsigned char prec, char *s) {
+  bool  negative = false;
+  char *out      = s;
+  int   fillme   = width;
+
+  if (prec > 0) fillme -= (prec + 1);
+  if (number < 0.0) {
+    negative = true;
+    fillme--;
+    number = -number;
+  }
+
+  // Runden: 0.5 in der letzten Stelle
+  double rounding = 2.0;
+  for (uint8_t i = 0; i < prec; ++i) rounding *= 10.0;
+  rounding = 1.0 / rounding;
+  number += rounding;
+
+  // Auf eine Stelle vor dem Komma normieren
+  double tenpow     = 1.0;
+  int    digitcount = 1;
+  while (number >= 10.0 * tenpow) {
+    tenpow *= 10.0;
+    digitcount++;
+  }
+  number /= tenpow;
+  fillme -= digitcount;
+
+  while (fillme-- > 0) *out++ = ' ';
+  if (negative) *out++ = '-';
+
+  digitcount += prec;
+  int8_t digit = 0;
+  while (digitcount-- > 0) {
+    digit = (int8_t)number;
+    if (digit > 9) digit = 9;
+    *out++ = (char)('0' | digit);
+    if ((digitcount == prec) && (prec > 0)) *out++ = '.';
+    number -= digit;
+    number *= 10.0;
+  }
+  *out = 0;
+  return s;
+}
@@ -0,0 +1,59 @@
+#ifndef SIM_ARDUINO_H
+#define SIM_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <errno.h>
+
+#include "sim_clock.h"
+
+// ----------------------------------------------------
+// Arduino-Kern für den Host (env:native)
+//
+// Nur, was die Scan-Module und die OPT3001-Bibliothek
+// brauchen. Zeit läuft auf der simulierten Uhr (delay()
+// schiebt sie weiter), die Pin-Funktionen wirken auf die
+// Leitungen des simulierten Busses, dessen SDA/SCL-Pins
+// gerade angesprochen werden (siehe TwoWire::begin()).
+// ----------------------------------------------------
+typedef bool    boolean;
+typedef uint8_t byte;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT             0x01
+#define OUTPUT            0x03
+#define PULLUP            0x04
+#define INPUT_PULLUP      0x05
+#define OPEN_DRAIN        0x10
+#define OUTPUT_OPEN_DRAIN 0x13
+
+// Board-Default wie pins_arduino.h des ESP32-POE-ISO
+static const uint8_t SDA = 13;
+static const uint8_t SCL = 16;
+
+#define PRO_CPU_NUM 0
+#define APP_CPU_NUM 1
+
+typedef uint32_t TickType_t;
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms)  ((TickType_t)(ms))
+
+inline unsigned long micros() { return (unsigned long)(uint32_t)(sim::nowNs() / 1000); }
+inline unsigned long millis() { return (unsigned long)(uint32_t)(sim::nowNs() / 1000000); }
+inline void delay(uint32_t ms) { sim::advanceNs((uint64_t)ms * 1000000); }
+inline void delayMicroseconds(uint32_t us) { sim::advanceUs(us); }
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int  digitalRead(uint8_t pin);
+
+// stdlib_noniso des Arduino-ESP32-Kerns (gleicher Algorithmus)
+char *dtostrf(double number, signed char width, unsigned char prec, char *s);
+
+#endif
@@ -0,0 +1,63 @@
+#include "Preferences.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+typedef std::map<std::string, std::vector<uint8_t> > Namespace;
+
+static std::map<std::string, Namespace> s_nvs;
+
+bool Preferences::begin(const char *name, bool readOnly) {
+  if (m_started || name == NULL) return false;
+  // Read-only auf einen nie geschriebenen Namespace scheitert wie auf dem Gerät
+  if (readOnly && !s_nvs.count(name)) return false;
+  m_started  = true;
+  m_readOnly = readOnly;
+  m_name     = name;
+  return true;
+}
+
+void Preferences::end() {
+  m_started = false;
+}
+
+bool Preferences::clear() {
+  if (!m_started || m_readOnly) return false;
+  s_nvs[m_name].clear();
+  return true;
+}
+
+bool Preferences::remove(const char *key) {
+  if (!m_started || m_readOnly || key == NULL) return false;
+  return s_nvs[m_name].erase(key) > 0;
+}
+
+bool Preferences::isKey(const char *key) {
+  return m_started && key != NULL && s_nvs[m_name].count(key) > 0;
+}
+
+size_t Preferences::putBytes(const char *key, const void *value, size_t len) {
+  if (!m_started || m_readOnly || key == NULL || value == NULL || len == 0) return 0;
+  const uint8_t *bytes = (const uint8_t *)value;
+  s_nvs[m_name][key].assign(bytes, bytes + len);
+  return len;
+}
+
+size_t Preferences::getBytesLength(const char *key) {
+  if (!isKey(key)) return 0;
+  return s_nvs[m_name][key].size();
+}
+
+size_t Preferences::getBytes(const char *key, void *buf, size_t maxLen) {
+  size_t len = getBytesLength(key);
+  if (len == 0 || buf == NULL || len > maxLen) return 0;
+  memcpy(buf, &s_nvs[m_name][key][0], len);
+  return len;
+}
+
+namespace sim {
+
+void erasePreferences() { s_nvs.clear(); }
+
+}
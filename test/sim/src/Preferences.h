@@ -0,0 +1,39 @@
+#ifndef SIM_PREFERENCES_H
+#define SIM_PREFERENCES_H
+
+#include "Arduino.h"
+
+// ----------------------------------------------------
+// Preferences (NVS) im Speicher
+//
+// Ein Namespace je begin(), Schlüssel mit Bytes-Werten;
+// mehr benutzt die Firmware nicht. Der Inhalt bleibt über
+// sim::reset() hinweg erhalten wie der NVS über einen
+// Neustart, sim::erasePreferences() löscht ihn.
+// ----------------------------------------------------
+class Preferences {
+public:
+  bool   begin(const char *name, bool readOnly = false);
+  void   end();
+
+  bool   clear();
+  bool   remove(const char *key);
+  bool   isKey(const char *key);
+
+  size_t putBytes(const char *key, const void *value, size_t len);
+  size_t getBytesLength(const char *key);
+  size_t getBytes(const char *key, void *buf, size_t maxLen);
+
+private:
+  bool        m_started  = false;
+  bool        m_readOnly = false;
+  const char *m_name     = NULL;
+};
+
+namespace sim {
+
+void erasePreferences();
+
+}
+
+#endif
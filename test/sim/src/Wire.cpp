@@ -0,0 +1,102 @@
+#include "Wire.h"
+
+TwoWire Wire(0);
+TwoWire Wire1(1);
+
+bool TwoWire::begin(int sda, int scl, uint32_t frequency) {
+  if (bus().driver()) return true;   // läuft schon
+  if (sda < 0) sda = m_port == 0 ? SDA : -1;
+  if (scl < 0) scl = m_port == 0 ? SCL : -1;
+  bus().setPins(sda, scl);
+  bus().setFrequency(frequency ? frequency : 100000);
+  bus().setTimeoutMs(m_timeoutMs);
+  bus().setDriver(true);
+  return true;
+}
+
+bool TwoWire::end() {
+  bus().setDriver(false);
+  return true;
+}
+
+bool TwoWire::setClock(uint32_t frequency) {
+  bus().setFrequency(frequency);
+  return true;
+}
+
+void TwoWire::setTimeOut(uint16_t timeOutMillis) {
+  m_timeoutMs = timeOutMillis;
+  bus().setTimeoutMs(timeOutMillis);
+}
+
+// ----------------------------------------------------
+// Schreiben
+// ----------------------------------------------------
+void TwoWire::beginTransmission(uint16_t address) {
+  m_nonStop   = false;
+  m_txAddress = address;
+  m_txLength  = 0;
+}
+
+size_t TwoWire::write(uint8_t data) {
+  if (m_txLength >= I2C_BUFFER_LENGTH) return 0;
+  m_txBuffer[m_txLength++] = data;
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t *data, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    if (!write(data[i])) return i;
+  }
+  return size;
+}
+
+uint8_t TwoWire::endTransmission(bool sendStop) {
+  if (!sendStop) {
+    m_nonStop = true;   // Schreibteil läuft mit requestFrom()
+    return 0;
+  }
+  switch (transfer(m_txAddress, m_txBuffer, m_txLength, true, NULL, 0)) {
+    case SIM_OK:        return 0;
+    case SIM_NACK_ADDR:
+    case SIM_NACK_DATA: return 2;
+    case SIM_TIMEOUT:   return 5;
+    default:            return 4;
+  }
+}
+
+// ----------------------------------------------------
+// Lesen
+// ----------------------------------------------------
+size_t TwoWire::requestFrom(uint16_t address, size_t size, bool sendStop) {
+  (void)sendStop;   // der Kern schließt Lesezugriffe immer mit STOP ab
+  if (size > I2C_BUFFER_LENGTH) size = I2C_BUFFER_LENGTH;
+  m_rxIndex  = 0;
+  m_rxLength = 0;
+
+  bool nonStop = m_nonStop && m_txAddress == address;
+  m_nonStop = false;
+  if (transfer(address, m_txBuffer, m_txLength, nonStop, m_rxBuffer, size) != SIM_OK) return 0;
+  m_rxLength = size;
+  return size;
+}
+
+// ----------------------------------------------------
+// Ein Zugriff auf dem Bus
+// ----------------------------------------------------
+SimStatus TwoWire::transfer(uint16_t address, const uint8_t *tx, size_t txLength, bool write,
+                            uint8_t *rx, size_t rxLength) {
+  SimBus &b = bus();
+  SimStatus st = SIM_OK;
+
+  if (write) {
+    st = b.start(address, false);
+    for (size_t i = 0; st == SIM_OK && i < txLength; i++) st = b.write(tx[i]);
+  }
+  if (st == SIM_OK && rxLength) {
+    st = b.start(address, true);
+    for (size_t i = 0; st == SIM_OK && i < rxLength; i++) rx[i] = b.read(i + 1 == rxLength);
+  }
+  if (st != SIM_TIMEOUT) b.stop();   // nach Timeout hat der Bus schon aufgegeben
+  return st;
+}
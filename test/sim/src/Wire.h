@@ -0,0 +1,78 @@
+#ifndef SIM_WIRE_H
+#define SIM_WIRE_H
+
+#include "Arduino.h"
+#include "sim_bus.h"
+
+#define I2C_BUFFER_LENGTH 128
+
+// ----------------------------------------------------
+// TwoWire auf dem simulierten Bus
+//
+// Verhält sich wie TwoWire des Arduino-ESP32-Kerns 2.x:
+//  - endTransmission(false) schickt noch nichts, der
+//    Schreibteil läuft mit dem folgenden requestFrom() als
+//    ein Zugriff mit Repeated Start
+//  - Rückgabe von endTransmission(): 0 = ok, 2 = NACK (der
+//    Kern unterscheidet Adresse und Daten nicht), 4 = Bus-
+//    Fehler bzw. Treiber nicht gestartet, 5 = Timeout
+//  - requestFrom() liefert die Anzahl gelesener Bytes,
+//    bei jedem Fehler 0
+// Wire arbeitet auf sim::bus(0), Wire1 auf sim::bus(1).
+// ----------------------------------------------------
+class TwoWire {
+public:
+  explicit TwoWire(uint8_t busNum) : m_port(busNum) {}
+
+  bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0);
+  bool end();
+  bool setClock(uint32_t frequency);
+  uint32_t getClock() { return bus().frequency(); }
+  void setTimeOut(uint16_t timeOutMillis);
+  uint16_t getTimeOut() { return m_timeoutMs; }
+
+  void    beginTransmission(uint16_t address);
+  void    beginTransmission(uint8_t address) { beginTransmission((uint16_t)address); }
+  void    beginTransmission(int address) { beginTransmission((uint16_t)address); }
+  uint8_t endTransmission(bool sendStop);
+  uint8_t endTransmission() { return endTransmission(true); }
+
+  size_t  requestFrom(uint16_t address, size_t size, bool sendStop);
+  uint8_t requestFrom(uint8_t address, uint8_t size, uint8_t sendStop) {
+    return requestFrom((uint16_t)address, (size_t)size, (bool)sendStop);
+  }
+  uint8_t requestFrom(uint8_t address, uint8_t size) {
+    return requestFrom((uint16_t)address, (size_t)size, true);
+  }
+  uint8_t requestFrom(int address, int size) {
+    return requestFrom((uint16_t)address, (size_t)size, true);
+  }
+
+  size_t write(uint8_t data);
+  size_t write(const uint8_t *data, size_t size);
+  int    available() { return m_rxLength - m_rxIndex; }
+  int    read() { return m_rxIndex < m_rxLength ? m_rxBuffer[m_rxIndex++] : -1; }
+  int    peek() { return m_rxIndex < m_rxLength ? m_rxBuffer[m_rxIndex] : -1; }
+  void   flush() { m_rxIndex = m_rxLength = m_txLength = 0; }
+
+private:
+  SimBus &bus() { return sim::bus(m_port); }
+  // Ein Zugriff: optional schreiben, optional (Repeated Start) lesen, STOP
+  SimStatus transfer(uint16_t address, const uint8_t *tx, size_t txLength, bool write,
+                     uint8_t *rx, size_t rxLength);
+
+  uint8_t  m_port;
+  uint16_t m_timeoutMs = 50;
+  uint16_t m_txAddress = 0;
+  uint8_t  m_txBuffer[I2C_BUFFER_LENGTH];
+  size_t   m_txLength  = 0;
+  bool     m_nonStop   = false;
+  uint8_t  m_rxBuffer[I2C_BUFFER_LENGTH];
+  size_t   m_rxIndex   = 0;
+  size_t   m_rxLength  = 0;
+};
+
+extern TwoWire Wire;
+extern TwoWire Wire1;
+
+#endif
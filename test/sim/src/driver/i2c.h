@@ -0,0 +1,60 @@
+#ifndef SIM_DRIVER_I2C_H
+#define SIM_DRIVER_I2C_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// ----------------------------------------------------
+// ESP-IDF 4.4 I2C-Master-Command-Link auf dem simulierten Bus
+//
+// Die Kommandos landen im übergebenen Puffer und werden
+// von i2c_master_cmd_begin() der Reihe nach auf
+// sim::bus(port) ausgeführt: nach START ist das erste
+// geschriebene Byte die Adresse. Wie im Treiber bricht ein
+// fehlendes ACK (bei ack_en) die Kette mit STOP ab.
+// Rückgaben: ESP_OK, ESP_FAIL (NACK), ESP_ERR_TIMEOUT
+// (Bus hängt), ESP_ERR_INVALID_STATE (Port ohne Treiber,
+// d. h. TwoWire::begin() nicht aufgerufen).
+// ----------------------------------------------------
+typedef int esp_err_t;
+#define ESP_OK                 0
+#define ESP_FAIL               -1
+#define ESP_ERR_NO_MEM         0x101
+#define ESP_ERR_INVALID_ARG    0x102
+#define ESP_ERR_INVALID_STATE  0x103
+#define ESP_ERR_TIMEOUT        0x107
+
+typedef int i2c_port_t;
+#define I2C_NUM_0   0
+#define I2C_NUM_1   1
+#define I2C_NUM_MAX 2
+
+typedef void *i2c_cmd_handle_t;
+
+typedef enum {
+  I2C_MASTER_WRITE = 0,
+  I2C_MASTER_READ,
+} i2c_rw_t;
+
+typedef enum {
+  I2C_MASTER_ACK = 0,
+  I2C_MASTER_NACK,
+  I2C_MASTER_LAST_NACK,
+} i2c_ack_type_t;
+
+// Wie im IDF: Platz für n Transaktionen (START, Adresse, Daten, STOP)
+#define I2C_INTERNAL_STRUCT_SIZE     24
+#define I2C_LINK_RECOMMENDED_SIZE(n) (2 * I2C_INTERNAL_STRUCT_SIZE + I2C_INTERNAL_STRUCT_SIZE * (5 * (n)))
+
+i2c_cmd_handle_t i2c_cmd_link_create_static(uint8_t *buffer, uint32_t size);
+void      i2c_cmd_link_delete_static(i2c_cmd_handle_t cmd_handle);
+esp_err_t i2c_master_start(i2c_cmd_handle_t cmd_handle);
+esp_err_t i2c_master_write_byte(i2c_cmd_handle_t cmd_handle, uint8_t data, bool ack_en);
+esp_err_t i2c_master_write(i2c_cmd_handle_t cmd_handle, const uint8_t *data, size_t data_len, bool ack_en);
+esp_err_t i2c_master_read_byte(i2c_cmd_handle_t cmd_handle, uint8_t *data, i2c_ack_type_t ack);
+esp_err_t i2c_master_read(i2c_cmd_handle_t cmd_handle, uint8_t *data, size_t data_len, i2c_ack_type_t ack);
+esp_err_t i2c_master_stop(i2c_cmd_handle_t cmd_handle);
+esp_err_t i2c_master_cmd_begin(i2c_port_t i2c_num, i2c_cmd_handle_t cmd_handle, uint32_t ticks_to_wait);
+
+#endif
@@ -0,0 +1,128 @@
+#include "driver/i2c.h"
+#include "sim_bus.h"
+
+#include <new>
+
+// ----------------------------------------------------
+// Command-Link im Puffer des Aufrufers
+// ----------------------------------------------------
+enum SimCmdType : uint8_t { CMD_START, CMD_WRITE, CMD_READ, CMD_STOP };
+
+struct SimCmd {
+  SimCmdType type;
+  uint8_t    value;   // CMD_WRITE: Byte
+  bool       ack;     // CMD_WRITE: ACK prüfen; CMD_READ: letztes Byte mit NACK
+  uint8_t   *dest;    // CMD_READ: Ziel
+};
+
+struct SimCmdLink {
+  size_t capacity;
+  size_t count;
+  SimCmd cmds[1];
+};
+
+i2c_cmd_handle_t i2c_cmd_link_create_static(uint8_t *buffer, uint32_t size) {
+  // Puffer auf die Ausrichtung des Links bringen
+  uintptr_t align = alignof(SimCmdLink);
+  uint8_t  *start = (uint8_t *)(((uintptr_t)buffer + align - 1) & ~(align - 1));
+  size_t    used  = (size_t)(start - buffer) + offsetof(SimCmdLink, cmds);
+  if (buffer == NULL || size < used + sizeof(SimCmd)) return NULL;
+
+  SimCmdLink *link = new (start) SimCmdLink;
+  link->capacity = (size - used) / sizeof(SimCmd);
+  link->count    = 0;
+  return link;
+}
+
+void i2c_cmd_link_delete_static(i2c_cmd_handle_t cmd_handle) {
+  (void)cmd_handle;   // Speicher gehört dem Aufrufer
+}
+
+static esp_err_t append(i2c_cmd_handle_t cmd_handle, SimCmdType type, uint8_t value, bool ack, uint8_t *dest) {
+  SimCmdLink *link = (SimCmdLink *)cmd_handle;
+  if (link == NULL) return ESP_ERR_INVALID_ARG;
+  if (link->count >= link->capacity) return ESP_ERR_NO_MEM;
+  SimCmd &c = link->cmds[link->count++];
+  c.type  = type;
+  c.value = value;
+  c.ack   = ack;
+  c.dest  = dest;
+  return ESP_OK;
+}
+
+esp_err_t i2c_master_start(i2c_cmd_handle_t cmd_handle) {
+  return append(cmd_handle, CMD_START, 0, false, NULL);
+}
+
+esp_err_t i2c_master_write_byte(i2c_cmd_handle_t cmd_handle, uint8_t data, bool ack_en) {
+  return append(cmd_handle, CMD_WRITE, data, ack_en, NULL);
+}
+
+esp_err_t i2c_master_write(i2c_cmd_handle_t cmd_handle, const uint8_t *data, size_t data_len, bool ack_en) {
+  for (size_t i = 0; i < data_len; i++) {
+    esp_err_t err = i2c_master_write_byte(cmd_handle, data[i], ack_en);
+    if (err != ESP_OK) return err;
+  }
+  return ESP_OK;
+}
+
+esp_err_t i2c_master_read_byte(i2c_cmd_handle_t cmd_handle, uint8_t *data, i2c_ack_type_t ack) {
+  return append(cmd_handle, CMD_READ, 0, ack != I2C_MASTER_ACK, data);
+}
+
+esp_err_t i2c_master_read(i2c_cmd_handle_t cmd_handle, uint8_t *data, size_t data_len, i2c_ack_type_t ack) {
+  for (size_t i = 0; i < data_len; i++) {
+    bool last = (ack == I2C_MASTER_NACK) || (ack == I2C_MASTER_LAST_NACK && i + 1 == data_len);
+    esp_err_t err = append(cmd_handle, CMD_READ, 0, last, data + i);
+    if (err != ESP_OK) return err;
+  }
+  return ESP_OK;
+}
+
+esp_err_t i2c_master_stop(i2c_cmd_handle_t cmd_handle) {
+  return append(cmd_handle, CMD_STOP, 0, false, NULL);
+}
+
+// ----------------------------------------------------
+// Ausführen
+// ----------------------------------------------------
+esp_err_t i2c_master_cmd_begin(i2c_port_t i2c_num, i2c_cmd_handle_t cmd_handle, uint32_t ticks_to_wait) {
+  (void)ticks_to_wait;   // der Bus-Timeout gilt je Zugriff
+  SimCmdLink *link = (SimCmdLink *)cmd_handle;
+  if (link == NULL || i2c_num < 0 || i2c_num >= I2C_NUM_MAX) return ESP_ERR_INVALID_ARG;
+
+  SimBus &b = sim::bus(i2c_num);
+  if (!b.driver()) return ESP_ERR_INVALID_STATE;
+
+  bool addressNext = false;
+  for (size_t i = 0; i < link->count; i++) {
+    const SimCmd &c = link->cmds[i];
+    SimStatus st = SIM_OK;
+    switch (c.type) {
+      case CMD_START:
+        addressNext = true;
+        break;
+      case CMD_WRITE:
+        if (addressNext) {
+          addressNext = false;
+          st = b.start(c.value >> 1, c.value & 1);
+        } else {
+          st = b.write(c.value);
+        }
+        if (!c.ack && (st == SIM_NACK_ADDR || st == SIM_NACK_DATA)) st = SIM_OK;
+        break;
+      case CMD_READ:
+        *c.dest = b.read(c.ack);
+        break;
+      case CMD_STOP:
+        b.stop();
+        break;
+    }
+    if (st == SIM_TIMEOUT) return ESP_ERR_TIMEOUT;
+    if (st != SIM_OK) {
+      b.stop();
+      return ESP_FAIL;
+    }
+  }
+  return ESP_OK;
+}
@@ -0,0 +1,60 @@
+#ifndef SIM_BOARD_H
+#define SIM_BOARD_H
+
+#include "topology.h"
+#include "sim_bus.h"
+#include "sim_tca9548a.h"
+#include "sim_opt3001.h"
+
+// ----------------------------------------------------
+// Das Board aus topology.h als Simulation
+//
+// Je Mux ein TCA9548A-Modell auf dem Bus aus MUX_BUS, an
+// jedem Kanal die Sensoren aus SENSOR_ADDR. Alle Plätze
+// sind bestückt; Tests stecken einzelne Sensoren per
+// setPresent(false) ab. Lebt zwischen sim::reset() und dem
+// nächsten sim::reset() (die Busse halten Zeiger darauf).
+// ----------------------------------------------------
+class SimBoard {
+public:
+  SimBoard() {
+    for (uint8_t m = 0; m < NUM_MUXES; m++) {
+      m_mux[m] = new SimTca9548a(MUX_ADDR[m]);
+      sim::bus(MUX_BUS[m]).attach(*m_mux[m]);
+      for (uint8_t ch = 0; ch < MUX_CHANNEL_COUNT[m]; ch++) {
+        for (uint8_t k = 0; k < NUM_SENSORS_PER_CHANNEL; k++) {
+          SimOpt3001 *s = new SimOpt3001(SENSOR_ADDR[k]);
+          m_mux[m]->channel(ch).attach(*s);
+          m_sensor[m][ch][k] = s;
+        }
+      }
+    }
+  }
+
+  ~SimBoard() {
+    for (uint8_t m = 0; m < NUM_MUXES; m++) {
+      for (uint8_t ch = 0; ch < MUX_CHANNEL_COUNT[m]; ch++)
+        for (uint8_t k = 0; k < NUM_SENSORS_PER_CHANNEL; k++) delete m_sensor[m][ch][k];
+      delete m_mux[m];
+    }
+  }
+
+  SimTca9548a &mux(uint8_t m) { return *m_mux[m]; }
+  SimOpt3001  &sensor(uint8_t m, uint8_t ch, uint8_t k) { return *m_sensor[m][ch][k]; }
+
+  // Alle Sensoren auf dieselbe Helligkeit
+  void setLux(double lux) {
+    for (uint8_t m = 0; m < NUM_MUXES; m++)
+      for (uint8_t ch = 0; ch < MUX_CHANNEL_COUNT[m]; ch++)
+        for (uint8_t k = 0; k < NUM_SENSORS_PER_CHANNEL; k++) m_sensor[m][ch][k]->setLux(lux);
+  }
+
+private:
+  SimBoard(const SimBoard &);
+  SimBoard &operator=(const SimBoard &);
+
+  SimTca9548a *m_mux[NUM_MUXES] = {};
+  SimOpt3001 *m_sensor[NUM_MUXES][SIM_TCA9548A_CHANNELS][NUM_SENSORS_PER_CHANNEL] = {};
+};
+
+#endif
@@ -0,0 +1,153 @@
+#include "sim_bus.h"
+#include "sim_clock.h"
+
+#include <algorithm>
+
+// ----------------------------------------------------
+// Segmente
+// ----------------------------------------------------
+void SimSegment::detach(SimDevice &dev) {
+  m_devices.erase(std::remove(m_devices.begin(), m_devices.end(), &dev), m_devices.end());
+}
+
+void SimSegment::reach(std::vector<SimDevice *> &out, uint64_t nowNs) const {
+  for (size_t i = 0; i < m_devices.size(); i++) {
+    out.push_back(m_devices[i]);
+    if (m_devices[i]->present()) m_devices[i]->reach(out, nowNs);   // abgesteckter Mux trennt
+  }
+}
+
+// ----------------------------------------------------
+// Zeit
+// ----------------------------------------------------
+void SimBus::bits(uint32_t n) {
+  uint64_t ns = (uint64_t)n * 1000000000ULL / m_hz;
+  m_stats.busyNs += ns;
+  sim::advanceNs(ns);
+}
+
+// Der Treiber wartet bis zum Timeout und gibt dann auf
+SimStatus SimBus::timeout() {
+  uint64_t ns = (uint64_t)m_timeoutMs * 1000000ULL;
+  m_stats.busyNs += ns;
+  m_stats.timeouts++;
+  sim::advanceNs(ns);
+  m_inTransaction = false;
+  m_selected.clear();
+  return SIM_TIMEOUT;
+}
+
+void SimBus::setDriver(bool active) {
+  m_driver = active;
+  if (!active) return;
+  // Der Treiber übernimmt die Pins wieder
+  m_sdaDrivenLow = false;
+  m_sclDrivenLow = false;
+  m_inTransaction = false;
+  m_selected.clear();
+}
+
+// ----------------------------------------------------
+// Byte-Ebene
+// ----------------------------------------------------
+SimStatus SimBus::start(uint8_t addr, bool read) {
+  if (!m_driver) return SIM_BUS_ERROR;
+  if (m_stuckClocks) return timeout();
+
+  if (!m_inTransaction) {
+    uint64_t ns = (uint64_t)m_overheadUs * 1000;
+    m_stats.busyNs += ns;
+    m_stats.transactions++;
+    sim::advanceNs(ns);
+  }
+  bits(1 + 9);   // (Repeated) START + Adressbyte mit ACK
+  m_stats.starts++;
+  m_stats.bytes++;
+  m_inTransaction = true;
+  m_reading       = read;
+
+  // Erreichbar ist, was jetzt durchgeschaltet und eingeschwungen ist
+  std::vector<SimDevice *> reachable;
+  m_root.reach(reachable, sim::nowNs());
+
+  m_selected.clear();
+  for (size_t i = 0; i < reachable.size(); i++) {
+    SimDevice *d = reachable[i];
+    if (!d->present() || d->address() != addr) continue;
+    if (d->maxHz() && m_hz > d->maxHz()) continue;   // versteht den Takt nicht
+    if (!d->start(read)) continue;
+    m_selected.push_back(d);
+    if (std::find(m_touched.begin(), m_touched.end(), d) == m_touched.end()) m_touched.push_back(d);
+  }
+
+  if (m_selected.size() > 1) m_stats.collisions++;
+  if (m_selected.empty()) {
+    m_stats.nacks++;
+    return SIM_NACK_ADDR;
+  }
+  return SIM_OK;
+}
+
+SimStatus SimBus::write(uint8_t value) {
+  if (!m_driver) return SIM_BUS_ERROR;
+  if (m_stuckClocks) return timeout();
+  bits(9);
+  m_stats.bytes++;
+
+  bool ack = false;
+  for (size_t i = 0; i < m_selected.size(); i++) ack |= m_selected[i]->write(value);
+  if (!ack) {
+    m_stats.nacks++;
+    return SIM_NACK_DATA;
+  }
+  return SIM_OK;
+}
+
+uint8_t SimBus::read(bool last) {
+  (void)last;
+  if (!m_driver || m_stuckClocks) return 0xFF;
+  bits(9);
+  m_stats.bytes++;
+
+  uint8_t value = 0xFF;   // Pull-up, wenn niemand treibt
+  for (size_t i = 0; i < m_selected.size(); i++) value &= m_selected[i]->read();
+  return value;
+}
+
+void SimBus::stop() {
+  if (!m_driver) return;
+  bits(1);
+  for (size_t i = 0; i < m_touched.size(); i++) m_touched[i]->stop();
+  m_touched.clear();
+  m_selected.clear();
+  m_inTransaction = false;
+}
+
+// ----------------------------------------------------
+// GPIO
+// ----------------------------------------------------
+// Jede steigende SCL-Flanke schiebt ein Bit des hängenden
+// Slaves hinaus
+void SimBus::driveScl(bool low) {
+  if (m_sclDrivenLow && !low) {
+    m_stats.recoveryClocks++;
+    if (m_stuckClocks) m_stuckClocks--;
+  }
+  m_sclDrivenLow = low;
+}
+
+// ----------------------------------------------------
+// Busse der beiden Controller
+// ----------------------------------------------------
+namespace sim {
+
+static SimBus s_bus[2];
+
+SimBus &bus(uint8_t port) { return s_bus[port & 1]; }
+
+void reset() {
+  for (uint8_t i = 0; i < 2; i++) s_bus[i] = SimBus();
+  resetClock();
+}
+
+}
@@ -0,0 +1,167 @@
+#ifndef SIM_BUS_H
+#define SIM_BUS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+// ----------------------------------------------------
+// Simulierter I2C-Bus
+//
+// Modelliert wird auf Byte-Ebene: START mit Adresse, Bytes
+// schreiben/lesen, STOP. Jeder Schritt kostet Buszeit nach
+// der eingestellten Taktrate (ein Byte = 9 Takte inkl. ACK,
+// START/STOP je ein Takt) und schiebt die simulierte Uhr
+// weiter; dazu kommt optional ein fester Treiber-Overhead
+// je Transaktion.
+//
+// Teilnehmer hängen an Segmenten: das Wurzelsegment ist
+// der Bus selbst, ein TCA9548A-Modell bringt je Kanal ein
+// eigenes Segment mit. Bei START wird gesammelt, was gerade
+// erreichbar ist; quittieren mehrere Teilnehmer dieselbe
+// Adresse, bekommen alle die geschriebenen Bytes und
+// Lesedaten werden verundet (Open-Drain), die Kollision
+// wird gezählt.
+//
+// Hält ein Teilnehmer SDA fest (holdSdaLow()), endet jeder
+// Zugriff nach dem Timeout mit SIM_TIMEOUT, bis über die
+// GPIO-Funktionen genug SCL-Takte erzeugt wurden.
+// ----------------------------------------------------
+enum SimStatus {
+  SIM_OK = 0,
+  SIM_NACK_ADDR,   // Adresse nicht quittiert
+  SIM_NACK_DATA,   // Datenbyte nicht quittiert
+  SIM_BUS_ERROR,   // Treiber nicht aktiv
+  SIM_TIMEOUT,     // Bus hängt (SDA low)
+};
+
+class SimDevice;
+
+class SimSegment {
+public:
+  void attach(SimDevice &dev) { m_devices.push_back(&dev); }
+  void detach(SimDevice &dev);
+
+  // Erreichbare Teilnehmer (inkl. nachgelagerter Segmente) anhängen
+  void reach(std::vector<SimDevice *> &out, uint64_t nowNs) const;
+
+  const std::vector<SimDevice *> &devices() const { return m_devices; }
+
+private:
+  std::vector<SimDevice *> m_devices;
+};
+
+class SimDevice {
+public:
+  virtual ~SimDevice() {}
+
+  virtual uint8_t address() const = 0;
+  // Höchste Taktrate, die der Baustein versteht (0 = beliebig)
+  virtual uint32_t maxHz() const { return 0; }
+
+  // START mit der eigenen Adresse. false = NACK
+  virtual bool start(bool read) = 0;
+  // Vom Master geschriebenes Byte. false = NACK
+  virtual bool write(uint8_t value) = 0;
+  // Vom Master gelesenes Byte
+  virtual uint8_t read() = 0;
+  // STOP (nicht bei Repeated Start)
+  virtual void stop() {}
+
+  // Nachgelagerte Segmente, die gerade durchgeschaltet sind
+  virtual void reach(std::vector<SimDevice *> &, uint64_t) const {}
+
+  // Abgesteckt: quittiert nichts mehr
+  void setPresent(bool present) { m_present = present; }
+  bool present() const { return m_present; }
+
+private:
+  bool m_present = true;
+};
+
+class SimBus {
+public:
+  // --- Aufbau ---
+  SimSegment &root() { return m_root; }
+  void attach(SimDevice &dev) { m_root.attach(dev); }
+
+  void     setFrequency(uint32_t hz) { m_hz = hz ? hz : 100000; }
+  uint32_t frequency() const { return m_hz; }
+  // Fester Aufschlag je Transaktion (Treiber, Interrupts)
+  void     setOverheadUs(uint32_t us) { m_overheadUs = us; }
+  void     setTimeoutMs(uint32_t ms) { m_timeoutMs = ms; }
+
+  // --- Treiberzustand (TwoWire::begin/end) ---
+  void setDriver(bool active);
+  bool driver() const { return m_driver; }
+  void setPins(int sda, int scl) { m_sda = sda; m_scl = scl; }
+  int  sdaPin() const { return m_sda; }
+  int  sclPin() const { return m_scl; }
+
+  // --- Byte-Ebene ---
+  SimStatus start(uint8_t addr, bool read);
+  SimStatus write(uint8_t value);
+  uint8_t   read(bool last);
+  void      stop();
+  bool      active() const { return m_inTransaction; }
+
+  // --- Fehler injizieren ---
+  // Ein Slave hält SDA für 'clocks' SCL-Takte low
+  void holdSdaLow(uint8_t clocks) { m_stuckClocks = clocks; }
+  bool sdaStuck() const { return m_stuckClocks > 0; }
+
+  // --- GPIO (Bus-Recovery per pinMode/digitalWrite) ---
+  void driveSda(bool low) { m_sdaDrivenLow = low; }
+  void driveScl(bool low);
+  bool sdaLevel() const { return !(m_stuckClocks > 0 || m_sdaDrivenLow); }
+  bool sclLevel() const { return !m_sclDrivenLow; }
+
+  // --- Zähler ---
+  struct Stats {
+    uint32_t transactions;   // bis zum STOP (je Treiberaufruf, trägt den Overhead)
+    uint32_t starts;         // START inkl. Repeated Start
+    uint32_t bytes;          // Adress- und Datenbytes
+    uint32_t nacks;
+    uint32_t collisions;     // START mit mehreren quittierenden Teilnehmern
+    uint32_t timeouts;
+    uint32_t recoveryClocks; // per GPIO erzeugte SCL-Takte
+    uint64_t busyNs;         // Buszeit inkl. Overhead
+  };
+  const Stats &stats() const { return m_stats; }
+  void resetStats() { m_stats = Stats(); }
+
+private:
+  void bits(uint32_t n);
+  SimStatus timeout();
+
+  SimSegment  m_root;
+  uint32_t    m_hz         = 100000;
+  uint32_t    m_overheadUs = 0;
+  uint32_t    m_timeoutMs  = 50;
+  bool        m_driver     = false;
+  int         m_sda        = -1;
+  int         m_scl        = -1;
+
+  bool        m_inTransaction = false;
+  bool        m_reading       = false;
+  std::vector<SimDevice *> m_selected;   // quittierende Teilnehmer
+  std::vector<SimDevice *> m_touched;    // seit dem letzten STOP angesprochen
+
+  uint8_t     m_stuckClocks  = 0;
+  bool        m_sdaDrivenLow = false;
+  bool        m_sclDrivenLow = false;
+
+  Stats       m_stats = Stats();
+};
+
+namespace sim {
+
+// Bus eines I2C-Controllers (0 = Wire, 1 = Wire1)
+SimBus &bus(uint8_t port);
+
+// Beide Busse leeren, Zähler und Uhr zurücksetzen
+void reset();
+
+}
+
+#endif
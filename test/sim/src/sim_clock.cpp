@@ -0,0 +1,11 @@
+#include "sim_clock.h"
+
+namespace sim {
+
+static uint64_t s_nowNs = 0;
+
+uint64_t nowNs() { return s_nowNs; }
+void advanceNs(uint64_t ns) { s_nowNs += ns; }
+void resetClock(uint64_t ns) { s_nowNs = ns; }
+
+}
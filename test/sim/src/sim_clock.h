@@ -0,0 +1,24 @@
+#ifndef SIM_CLOCK_H
+#define SIM_CLOCK_H
+
+#include <stdint.h>
+
+// ----------------------------------------------------
+// Simulierte Zeit
+//
+// micros(), millis() und delay*() des Host-Arduino-Kerns
+// laufen auf dieser Uhr, ebenso die Busdauer jedes I2C-
+// Zugriffs und die Wandlungszeit der OPT3001-Modelle. Sie
+// steht, solange niemand wartet oder den Bus benutzt:
+// Rechenzeit auf dem Host zählt nicht.
+// ----------------------------------------------------
+namespace sim {
+
+uint64_t nowNs();
+void     advanceNs(uint64_t ns);
+inline void advanceUs(uint64_t us) { advanceNs(us * 1000); }
+void     resetClock(uint64_t ns = 0);
+
+}
+
+#endif
@@ -0,0 +1,159 @@
+#include "sim_opt3001.h"
+#include "sim_clock.h"
+
+#include <math.h>
+
+// Config-Felder
+#define CFG_RN(c)     ((c) >> 12)
+#define CFG_CT        (1 << 11)
+#define CFG_MODE(c)   (((c) >> 9) & 3)
+#define CFG_OVF       (1 << 8)
+#define CFG_CRF       (1 << 7)
+#define CFG_FH        (1 << 6)
+#define CFG_FL        (1 << 5)
+#define CFG_L         (1 << 4)
+#define CFG_FC(c)     ((c) & 3)
+#define CFG_WRITABLE  0xFE1F
+
+#define MODE_SHUTDOWN   0
+#define MODE_SINGLESHOT 1
+
+// Exakter Wert in Centilux (Mantisse << Exponent)
+static uint32_t centilux(uint16_t raw) {
+  return (uint32_t)(raw & 0x0FFF) << (raw >> 12);
+}
+
+uint16_t SimOpt3001::encode(double lux, uint8_t rn) {
+  double c = lux > 0 ? lux * 100.0 : 0.0;
+  uint8_t e = 0;
+  if (rn >= 12) {
+    while (e < 11 && c / (1 << e) > 4095.0) e++;
+  } else {
+    e = rn;
+  }
+  double m = floor(c / (1 << e) + 0.5);
+  if (m > 4095) m = 4095;
+  return (uint16_t)(e << 12) | (uint16_t)m;
+}
+
+// ----------------------------------------------------
+// Wandlungen
+// ----------------------------------------------------
+uint64_t SimOpt3001::conversionNs() const {
+  double ms = (m_config & CFG_CT) ? 800.0 : 100.0;
+  return (uint64_t)(ms * m_oscillator * 1000000.0);
+}
+
+void SimOpt3001::update() {
+  while (CFG_MODE(m_config) != MODE_SHUTDOWN && sim::nowNs() - m_convStartNs >= conversionNs()) {
+    m_convStartNs += conversionNs();
+    complete();
+    if (CFG_MODE(m_config) == MODE_SINGLESHOT) {
+      m_config &= ~(3 << 9);   // zurück auf Shutdown
+      break;
+    }
+  }
+}
+
+void SimOpt3001::complete() {
+  m_result = encode(m_lux, CFG_RN(m_config));
+  m_config |= CFG_CRF;
+  if (m_lux * 100.0 > (4095UL << 11)) m_config |= CFG_OVF;
+  else m_config &= ~CFG_OVF;
+  m_conversions++;
+
+  // End-of-Conversion-Modus (Low-Limit-Exponent 1100b): keine Limits
+  if ((m_low >> 12) == 0xC) return;
+
+  uint32_t value = centilux(m_result);
+  bool above = value > centilux(m_high);
+  bool below = value < centilux(m_low);
+  static const uint8_t FAULTS[4] = { 1, 2, 4, 8 };
+  m_faults = (above || below) ? m_faults + 1 : 0;
+  if (m_faults < FAULTS[CFG_FC(m_config)]) {
+    if (!(m_config & CFG_L) && !above && !below) m_config &= ~(CFG_FH | CFG_FL);   // transparent
+    return;
+  }
+
+  if (above) m_config |= CFG_FH;
+  if (below) m_config |= CFG_FL;
+  if (!(m_config & CFG_L)) {
+    if (!above) m_config &= ~CFG_FH;
+    if (!below) m_config &= ~CFG_FL;
+  }
+}
+
+// ----------------------------------------------------
+// Register
+// ----------------------------------------------------
+uint16_t SimOpt3001::readRegister(uint8_t reg) {
+  update();
+  switch (reg) {
+    case 0x00:
+      m_resultReads++;
+      return m_result;
+    case 0x01: {
+      m_configReads++;
+      uint16_t value = m_config;
+      m_config &= ~CFG_CRF;
+      if (m_config & CFG_L) m_config &= ~(CFG_FH | CFG_FL);
+      return value;
+    }
+    case 0x02: return m_low;
+    case 0x03: return m_high;
+    case 0x7E: return SIM_OPT3001_MANUID;
+    case 0x7F: return SIM_OPT3001_DEVICEID;
+    default:   return 0;
+  }
+}
+
+void SimOpt3001::writeRegister(uint8_t reg, uint16_t value) {
+  update();
+  switch (reg) {
+    case 0x01: {
+      uint8_t before = CFG_MODE(m_config);
+      m_config = (m_config & ~CFG_WRITABLE) | (value & CFG_WRITABLE);
+      uint8_t mode = CFG_MODE(m_config);
+      if (mode != MODE_SHUTDOWN) {
+        m_config &= ~CFG_CRF;
+        if (mode != before || mode == MODE_SINGLESHOT) m_convStartNs = sim::nowNs();
+      }
+      break;
+    }
+    case 0x02: m_low  = value; break;
+    case 0x03: m_high = value; break;
+    default:   break;   // Result und IDs sind nur lesbar
+  }
+}
+
+// ----------------------------------------------------
+// Bus
+// ----------------------------------------------------
+bool SimOpt3001::start(bool read) {
+  if (m_nackNext) {
+    m_nackNext--;
+    return false;
+  }
+  m_index = 0;
+  if (read) {
+    uint16_t value = readRegister(m_pointer);
+    m_data[0] = value >> 8;
+    m_data[1] = value;
+  }
+  return true;
+}
+
+bool SimOpt3001::write(uint8_t value) {
+  if (m_index < 3) m_written[m_index] = value;
+  m_index++;
+  if (m_index == 1) {
+    m_pointer = value;
+    m_pointerWrites++;
+  }
+  if (m_index == 3) writeRegister(m_written[0], (uint16_t)m_written[1] << 8 | m_written[2]);
+  return true;
+}
+
+uint8_t SimOpt3001::read() {
+  return m_index < 2 ? m_data[m_index++] : 0xFF;
+}
@@ -0,0 +1,90 @@
+#ifndef SIM_OPT3001_H
+#define SIM_OPT3001_H
+
+#include "sim_bus.h"
+
+// ----------------------------------------------------
+// OPT3001: Umgebungslichtsensor
+//
+// Register wie im Datenblatt: Result, Config (Reset 0xC810,
+// beschreibbar 0xFE1F), Low-/High-Limit, Manufacturer- und
+// Device-ID. Ein Byte schreiben setzt den Register-Pointer,
+// drei Bytes schreiben zusätzlich das Register; gelesen
+// werden zwei Bytes ab Pointer (MSB zuerst).
+//
+// Wandlungen laufen auf der simulierten Uhr: 100 bzw.
+// 800 ms (CT), skaliert mit der Oszillator-Abweichung.
+// Continuous wandelt fortlaufend, Single-Shot einmal und
+// fällt dann auf Shutdown zurück. Jede fertige Wandlung
+// übernimmt den eingestellten Lux-Wert (automatischer bzw.
+// fester Messbereich) und setzt CRF; Lesen der Config
+// löscht CRF (Latch-Modus auch FH/FL), Schreiben mit
+// M != Shutdown ebenfalls. FH/FL vergleichen das Ergebnis
+// mit den Limits nach Fault-Count.
+// ----------------------------------------------------
+#define SIM_OPT3001_MANUID   0x5449
+#define SIM_OPT3001_DEVICEID 0x3001
+
+class SimOpt3001 : public SimDevice {
+public:
+  explicit SimOpt3001(uint8_t addr) : m_addr(addr) {}
+
+  // --- Szene ---
+  void   setLux(double lux) { m_lux = lux; }
+  double lux() const { return m_lux; }
+  // Wandlungszeit-Faktor (Datenblatt: ±10 %)
+  void   setOscillator(double factor) { m_oscillator = factor; }
+  // Die nächsten 'count' Adressierungen nicht quittieren
+  void   nackNext(uint8_t count) { m_nackNext = count; }
+
+  // --- Zustand (für Prüfungen) ---
+  uint16_t config() { update(); return m_config; }
+  uint16_t result() { update(); return m_result; }
+  uint16_t limitLow() const { return m_low; }
+  uint16_t limitHigh() const { return m_high; }
+  uint32_t conversions() { update(); return m_conversions; }
+  uint32_t configReads() const { return m_configReads; }
+  uint32_t resultReads() const { return m_resultReads; }
+  // Schreibzugriffe: jeder setzt den Register-Pointer
+  uint32_t pointerWrites() const { return m_pointerWrites; }
+
+  // Lux → Result-Register (rn = Messbereich, 12 = automatisch)
+  static uint16_t encode(double lux, uint8_t rn);
+
+  uint8_t address() const { return m_addr; }
+  bool    start(bool read);
+  bool    write(uint8_t value);
+  uint8_t read();
+
+private:
+  // Fertige Wandlungen bis jetzt nachholen
+  void     update();
+  void     complete();
+  uint64_t conversionNs() const;
+  uint16_t readRegister(uint8_t reg);
+  void     writeRegister(uint8_t reg, uint16_t value);
+
+  uint8_t  m_addr;
+  double   m_lux        = 0;
+  double   m_oscillator = 1.0;
+  uint8_t  m_nackNext   = 0;
+
+  uint8_t  m_pointer = 0;
+  uint16_t m_config  = 0xC810;
+  uint16_t m_low     = 0xC000;
+  uint16_t m_high    = 0xBFFF;
+  uint16_t m_result  = 0;
+  uint64_t m_convStartNs = 0;   // Beginn der laufenden Wandlung
+  uint8_t  m_faults      = 0;   // aufeinanderfolgende Ergebnisse außerhalb
+
+  uint8_t  m_index = 0;         // Byte im laufenden Zugriff
+  uint8_t  m_data[2];
+  uint8_t  m_written[3];
+
+  uint32_t m_conversions = 0;
+  uint32_t m_configReads = 0;
+  uint32_t m_resultReads = 0;
+  uint32_t m_pointerWrites = 0;
+};
+
+#endif
@@ -0,0 +1,33 @@
+#include "sim_tca9548a.h"
+#include "sim_clock.h"
+
+bool SimTca9548a::start(bool read) {
+  (void)read;
+  return true;
+}
+
+bool SimTca9548a::write(uint8_t value) {
+  m_pending = value;
+  m_written = true;
+  return true;
+}
+
+void SimTca9548a::stop() {
+  if (!m_written) return;
+  m_written = false;
+  m_writes++;
+
+  uint8_t opened = m_pending & ~m_control;
+  for (uint8_t ch = 0; ch < SIM_TCA9548A_CHANNELS; ch++) {
+    if (opened & (1 << ch)) m_sinceNs[ch] = sim::nowNs();
+  }
+  m_control = m_pending;
+}
+
+void SimTca9548a::reach(std::vector<SimDevice *> &out, uint64_t nowNs) const {
+  for (uint8_t ch = 0; ch < SIM_TCA9548A_CHANNELS; ch++) {
+    if (!(m_control & (1 << ch))) continue;
+    if (nowNs - m_sinceNs[ch] < (uint64_t)m_settleUs[ch] * 1000) continue;
+    m_channel[ch].reach(out, nowNs);
+  }
+}
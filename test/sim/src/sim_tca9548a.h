@@ -0,0 +1,51 @@
+#ifndef SIM_TCA9548A_H
+#define SIM_TCA9548A_H
+
+#include "sim_bus.h"
+
+// ----------------------------------------------------
+// TCA9548A: 8-Kanal-I2C-Switch
+//
+// Ein Control-Register, geschrieben und gelesen mit je
+// einem Byte; Bit n schaltet Kanal n durch. Wie im
+// Datenblatt wird eine neue Maske erst mit dem STOP aktiv
+// (mehrere Bytes in einem Zugriff: das letzte zählt). Ein
+// neu durchgeschalteter Kanal ist erst nach seiner
+// Settle-Zeit erreichbar (Leitungskapazität, Rise-Time);
+// Zugriffe davor sieht der Bus als NACK. Bis 400 kHz.
+// ----------------------------------------------------
+#define SIM_TCA9548A_CHANNELS 8
+#define SIM_TCA9548A_MAX_HZ   400000
+
+class SimTca9548a : public SimDevice {
+public:
+  explicit SimTca9548a(uint8_t addr) : m_addr(addr) {}
+
+  SimSegment &channel(uint8_t ch) { return m_channel[ch % SIM_TCA9548A_CHANNELS]; }
+  void setSettleUs(uint8_t ch, uint32_t us) { m_settleUs[ch % SIM_TCA9548A_CHANNELS] = us; }
+
+  uint8_t control() const { return m_control; }
+  // Control-Register von außen verfälschen (Störung, Brown-out)
+  void corrupt(uint8_t control) { m_control = control; }
+  uint32_t writes() const { return m_writes; }
+
+  uint8_t  address() const { return m_addr; }
+  uint32_t maxHz() const { return SIM_TCA9548A_MAX_HZ; }
+  bool     start(bool read);
+  bool     write(uint8_t value);
+  uint8_t  read() { return m_control; }
+  void     stop();
+  void     reach(std::vector<SimDevice *> &out, uint64_t nowNs) const;
+
+private:
+  uint8_t    m_addr;
+  uint8_t    m_control = 0;
+  uint8_t    m_pending = 0;
+  bool       m_written = false;
+  uint32_t   m_writes  = 0;
+  SimSegment m_channel[SIM_TCA9548A_CHANNELS];
+  uint32_t   m_settleUs[SIM_TCA9548A_CHANNELS] = {};
+  uint64_t   m_sinceNs[SIM_TCA9548A_CHANNELS]  = {};   // Kanal durchgeschaltet seit
+};
+
+#endif
@@ -0,0 +1,204 @@
+// ----------------------------------------------------
+// Bus-Recovery gegen einen hängenden Slave (env:native)
+//
+// Der simulierte Bus hält SDA für eine vorgegebene Zahl
+// SCL-Takte low, wie ein Sensor, der mitten im Lesen
+// zurückgesetzt wurde. Geprüft wird die Sequenz selbst
+// (Takte zählen, STOP, Wire wieder benutzbar), der Fall,
+// dass neun Takte nicht reichen, und dass Opt3001Array
+// den Hänger im laufenden Scan erkennt und danach wieder
+// alle Sensoren liest.
+// ----------------------------------------------------
+#include <unity.h>
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <Preferences.h>
+#include <opt3001.h>
+
+#include <sim_board.h>
+#include "bus_recovery.h"
+#include "opt3001_array.h"
+
+static BusRecovery  s_recovery;
+static Opt3001Array s_array;
+
+void setUp(void) {
+  sim::reset();
+  sim::erasePreferences();
+}
+
+void tearDown(void) {
+  Wire.end();
+}
+
+static void boot(Opt3001Array &array) {
+  Wire.begin(I2C0_SDA, I2C0_SCL, I2C_FREQ_HZ);
+  array.begin(Wire, 0);
+  array.loadMap();
+  array.reset();
+  array.configure(OPT3001_CONVERSION_TIME_100MS, true);
+  array.calibrateSettle();
+}
+
+static void run(Opt3001Array &array, uint32_t ms) {
+  const unsigned long end = millis() + ms;
+  while ((long)(end - millis()) > 0) {
+    array.service(micros());
+    delay(1);
+  }
+}
+
+static uint8_t countOk(const Opt3001Array &array) {
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < array.size(); i++) {
+    n += array.slot(i).status == 0 && array.slot(i).health == HEALTH_OK;
+  }
+  return n;
+}
+
+// Ein Schreibzugriff auf den ersten Mux
+static uint8_t probe() {
+  Wire.beginTransmission(MUX_ADDR[0]);
+  Wire.write((uint8_t)0x00);
+  return Wire.endTransmission();
+}
+
+// ----------------------------------------------------
+// BusRecovery allein
+// ----------------------------------------------------
+void test_stuck_bus_times_out_as_bus_error(void) {
+  SimTca9548a mux(MUX_ADDR[0]);
+  sim::bus(0).attach(mux);
+  Wire.begin(I2C0_SDA, I2C0_SCL, I2C_FREQ_HZ);
+  s_recovery.begin(Wire, I2C0_SDA, I2C0_SCL, I2C_FREQ_HZ);
+
+  TEST_ASSERT_EQUAL(0, probe());
+  TEST_ASSERT_TRUE(s_recovery.linesIdle());
+
+  sim::bus(0).holdSdaLow(5);
+  uint8_t res = probe();
+  TEST_ASSERT_EQUAL(5, res);
+  TEST_ASSERT_TRUE(BusRecovery::isBusError(res));
+  TEST_ASSERT_FALSE(BusRecovery::isBusError(2));   // NACK ist kein Bus-Fehler
+  TEST_ASSERT_FALSE(s_recovery.linesIdle());
+}
+
+void test_recovery_clocks_until_sda_released(void) {
+  SimTca9548a mux(MUX_ADDR[0]);
+  sim::bus(0).attach(mux);
+  Wire.begin(I2C0_SDA, I2C0_SCL, I2C_FREQ_HZ);
+  s_recovery.begin(Wire, I2C0_SDA, I2C0_SCL, I2C_FREQ_HZ);
+
+  sim::bus(0).holdSdaLow(5);
+  sim::bus(0).resetStats();
+  TEST_ASSERT_EQUAL(0, s_recovery.recover());
+
+  // Fünf Takte geben SDA frei, der sechste gehört zum STOP
+  TEST_ASSERT_EQUAL_UINT32(5 + 1, sim::bus(0).stats().recoveryClocks);
+  TEST_ASSERT_FALSE(sim::bus(0).sdaStuck());
+  TEST_ASSERT_TRUE(sim::bus(0).driver());
+  TEST_ASSERT_TRUE(s_recovery.linesIdle());
+  TEST_ASSERT_EQUAL(0, probe());
+  TEST_ASSERT_EQUAL_UINT32(1, s_recovery.recoveries());
+  TEST_ASSERT_EQUAL_UINT32(0, s_recovery.failures());
+}
+
+void test_recovery_gives_up_after_nine_clocks(void) {
+  SimTca9548a mux(MUX_ADDR[0]);
+  sim::bus(0).attach(mux);
+  Wire.begin(I2C0_SDA, I2C0_SCL, I2C_FREQ_HZ);
+  BusRecovery recovery;
+  recovery.begin(Wire, I2C0_SDA, I2C0_SCL, I2C_FREQ_HZ);
+
+  sim::bus(0).holdSdaLow(2 * (BUS_RECOVERY_CLOCKS + 1));
+  sim::bus(0).resetStats();
+  TEST_ASSERT_EQUAL(-EBUSY, recovery.recover());
+  TEST_ASSERT_EQUAL_UINT32(BUS_RECOVERY_CLOCKS + 1, sim::bus(0).stats().recoveryClocks);
+  TEST_ASSERT_TRUE(sim::bus(0).sdaStuck());
+  TEST_ASSERT_TRUE(sim::bus(0).driver());   // Wire läuft trotzdem wieder
+  TEST_ASSERT_EQUAL_UINT32(1, recovery.failures());
+
+  // Die zweite Sequenz schiebt den Rest hinaus
+  TEST_ASSERT_EQUAL(0, recovery.recover());
+  TEST_ASSERT_EQUAL(0, probe());
+  TEST_ASSERT_EQUAL_UINT32(2, recovery.recoveries());
+  TEST_ASSERT_EQUAL_UINT32(1, recovery.failures());
+}
+
+void test_recovery_without_pins(void) {
+  BusRecovery recovery;
+  TEST_ASSERT_EQUAL(-EINVAL, recovery.recover());
+  TEST_ASSERT_TRUE(recovery.linesIdle());
+}
+
+// ----------------------------------------------------
+// Im laufenden Scan
+// ----------------------------------------------------
+void test_scan_recovers_stuck_bus(void) {
+  SimBoard board;
+  board.setLux(250.0);
+  boot(s_array);
+  run(s_array, 300);
+  TEST_ASSERT_EQUAL(TOTAL_SENSORS, countOk(s_array));
+
+  // Zähler von BusRecovery laufen über die Tests weiter
+  const uint32_t recoveries0 = s_array.recovery().recoveries();
+  const uint32_t failures0   = s_array.recovery().failures();
+
+  sim::bus(0).holdSdaLow(7);
+  sim::bus(0).resetStats();
+  run(s_array, 20);
+  TEST_ASSERT_FALSE(sim::bus(0).sdaStuck());
+  TEST_ASSERT_TRUE(sim::bus(0).stats().timeouts > 0);
+  TEST_ASSERT_EQUAL_UINT32(recoveries0 + 1, s_array.recovery().recoveries());
+  TEST_ASSERT_EQUAL_UINT32(failures0, s_array.recovery().failures());
+
+  // Muxe aus dem Cache wiederhergestellt, Werte wieder frisch
+  board.setLux(1000.0);
+  run(s_array, 2000);
+  TEST_ASSERT_EQUAL(TOTAL_SENSORS, countOk(s_array));
+  for (uint8_t i = 0; i < s_array.size(); i++) {
+    TEST_ASSERT_FLOAT_WITHIN(5.0, 1000.0, opt3001::lux_from_raw(s_array.slot(i).raw));
+  }
+  TEST_ASSERT_EQUAL_UINT32(recoveries0 + 1, s_array.recovery().recoveries());
+}
+
+void test_scan_keeps_retrying_while_bus_hangs(void) {
+  SimBoard board;
+  board.setLux(250.0);
+  boot(s_array);
+  run(s_array, 300);
+
+  const uint32_t recoveries0 = s_array.recovery().recoveries();
+  const uint32_t failures0   = s_array.recovery().failures();
+
+  // Hängt länger als drei Sequenzen: jede nimmt neun Takte
+  // plus STOP, die vierte gibt den Bus frei
+  sim::bus(0).holdSdaLow(3 * (BUS_RECOVERY_CLOCKS + 1) + 5);
+  uint8_t fewestOk = TOTAL_SENSORS;
+  const unsigned long deadline = millis() + 5000;
+  while (sim::bus(0).sdaStuck() && (long)(deadline - millis()) > 0) {
+    run(s_array, 10);
+    if (countOk(s_array) < fewestOk) fewestOk = countOk(s_array);
+  }
+  TEST_ASSERT_FALSE(sim::bus(0).sdaStuck());
+  TEST_ASSERT_EQUAL_UINT32(failures0 + 3, s_array.recovery().failures());
+  TEST_ASSERT_EQUAL_UINT32(recoveries0 + 4, s_array.recovery().recoveries());
+  TEST_ASSERT_TRUE(fewestOk < TOTAL_SENSORS);
+
+  // Dabei ausgefallene Sensoren holen die Probes zurück
+  run(s_array, HEALTH_BACKOFF_MAX_MS + 1000);
+  TEST_ASSERT_EQUAL(TOTAL_SENSORS, countOk(s_array));
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_stuck_bus_times_out_as_bus_error);
+  RUN_TEST(test_recovery_clocks_until_sda_released);
+  RUN_TEST(test_recovery_gives_up_after_nine_clocks);
+  RUN_TEST(test_recovery_without_pins);
+  RUN_TEST(test_scan_recovers_stuck_bus);
+  RUN_TEST(test_scan_keeps_retrying_while_bus_hangs);
+  return UNITY_END();
+}
@@ -0,0 +1,169 @@
+// ----------------------------------------------------
+// SeqlockFrameBuffer unter Last
+//
+// Ein Schreiber-Thread veröffentlicht LuxFrames, deren
+// Inhalt vollständig aus der Frame-Nummer folgt; mehrere
+// Leser-Threads kopieren dauernd mit. Jede Kopie muss in
+// sich stimmig sein (kein Mix aus zwei Frames) und die
+// Frame-Nummern dürfen je Leser nie rückwärts laufen.
+// Auf dem Host laufen die Threads echt parallel, anders
+// als die zwei Tasks auf dem ESP32 mit Zeitscheiben.
+// ----------------------------------------------------
+#include <unity.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "frame_buffer.h"
+#include "lux_frame.h"
+
+#define STRESS_FRAMES  200000
+#define STRESS_READERS 3
+
+static SeqlockFrameBuffer<LuxFrame> s_frames;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// Inhalt eines Frames aus seiner Nummer
+static void fill(LuxFrame &f, uint32_t seq) {
+  f.seq         = seq;
+  f.timestamp   = seq * 3;
+  f.triggerUs   = 0;
+  f.scanStartUs = seq * 7;
+  f.scanEndUs   = seq * 7 + 1;
+  for (uint8_t r = 0; r < TOTAL_ROWS; r++) {
+    for (uint8_t c = 0; c < NUM_SENSORS_PER_CHANNEL; c++) {
+      f.raw[r][c]   = (uint16_t)(seq + LuxFrame::index(r, c));
+      f.ageMs[r][c] = (uint16_t)(seq >> 3);
+      f.code[r][c]  = (uint8_t)(seq % 5);
+    }
+  }
+  f.valid = (uint64_t)seq * 0x9E3779B97F4A7C15ull;
+}
+
+static bool consistent(const LuxFrame &f) {
+  LuxFrame expected;
+  fill(expected, f.seq);
+  return memcmp(&expected, &f, sizeof(LuxFrame)) == 0;
+}
+
+void test_read_before_publish(void) {
+  SeqlockFrameBuffer<LuxFrame> frames;
+  LuxFrame f;
+  TEST_ASSERT_FALSE(frames.read(f));
+  TEST_ASSERT_EQUAL_UINT32(0, frames.published());
+
+  fill(frames.beginWrite(), 1);
+  TEST_ASSERT_FALSE(frames.read(f));   // geöffnet, noch nicht veröffentlicht
+  frames.publish();
+  TEST_ASSERT_TRUE(frames.read(f));
+  TEST_ASSERT_EQUAL_UINT32(1, f.seq);
+  TEST_ASSERT_TRUE(consistent(f));
+}
+
+void test_concurrent_readers_never_see_torn_frames(void) {
+  std::atomic<bool>     done{false};
+  std::atomic<uint32_t> torn{0};
+  std::atomic<uint32_t> backwards{0};
+  std::atomic<uint64_t> copies{0};
+
+  std::vector<std::thread> readers;
+  for (uint8_t i = 0; i < STRESS_READERS; i++) {
+    readers.emplace_back([&]() {
+      LuxFrame f;
+      uint32_t last = 0;
+      uint64_t n    = 0;
+      while (!done.load(std::memory_order_acquire)) {
+        if (!s_frames.read(f)) continue;
+        if (!consistent(f)) torn++;
+        if (f.seq < last) backwards++;
+        last = f.seq;
+        n++;
+      }
+      copies += n;
+    });
+  }
+
+  std::thread writer([&]() {
+    for (uint32_t seq = 1; seq <= STRESS_FRAMES; seq++) {
+      fill(s_frames.beginWrite(), seq);
+      s_frames.publish();
+    }
+  });
+  writer.join();
+  done.store(true, std::memory_order_release);
+  for (size_t i = 0; i < readers.size(); i++) readers[i].join();
+
+  char line[96];
+  snprintf(line, sizeof(line), "%u Frames, %llu Kopien", (unsigned)STRESS_FRAMES,
+           (unsigned long long)copies.load());
+  TEST_MESSAGE(line);
+
+  TEST_ASSERT_EQUAL_UINT32(0, torn.load());
+  TEST_ASSERT_EQUAL_UINT32(0, backwards.load());
+  TEST_ASSERT_EQUAL_UINT32(STRESS_FRAMES, s_frames.published());
+  TEST_ASSERT_TRUE(copies.load() > 0);
+
+  LuxFrame last;
+  TEST_ASSERT_TRUE(s_frames.read(last));
+  TEST_ASSERT_EQUAL_UINT32(STRESS_FRAMES, last.seq);
+}
+
+// ----------------------------------------------------
+// Großer Frame (64 KB): die Kopie des Lesers ist lang genug,
+// dass der Schreiber ihn regelmäßig mitten darin überholt
+// (zweiter Core oder Verdrängung). Ohne die zweite Prüfung
+// des Sequenzzählers schlagen beide Lasttests fehl.
+// ----------------------------------------------------
+#define WIDE_WORDS 16384
+
+struct WideFrame {
+  uint32_t word[WIDE_WORDS];
+};
+
+static SeqlockFrameBuffer<WideFrame> s_wide;
+static WideFrame s_wideCopy[STRESS_READERS];
+
+void test_writer_overtaking_readers(void) {
+  std::atomic<bool>     done{false};
+  std::atomic<uint32_t> torn{0};
+
+  std::vector<std::thread> readers;
+  for (uint8_t i = 0; i < STRESS_READERS; i++) {
+    readers.emplace_back([&, i]() {
+      WideFrame &f = s_wideCopy[i];
+      while (!done.load(std::memory_order_acquire)) {
+        if (!s_wide.read(f)) continue;
+        for (uint32_t w = 1; w < WIDE_WORDS; w++) {
+          if (f.word[w] != f.word[0]) {
+            torn++;
+            break;
+          }
+        }
+      }
+    });
+  }
+
+  std::thread writer([&]() {
+    for (uint32_t seq = 1; seq <= STRESS_FRAMES / 10; seq++) {
+      WideFrame &f = s_wide.beginWrite();
+      for (uint32_t w = 0; w < WIDE_WORDS; w++) f.word[w] = seq;
+      s_wide.publish();
+    }
+  });
+  writer.join();
+  done.store(true, std::memory_order_release);
+  for (size_t i = 0; i < readers.size(); i++) readers[i].join();
+
+  TEST_ASSERT_EQUAL_UINT32(0, torn.load());
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_read_before_publish);
+  RUN_TEST(test_concurrent_readers_never_see_torn_frames);
+  RUN_TEST(test_writer_overtaking_readers);
+  return UNITY_END();
+}
@@ -0,0 +1,182 @@
+// ----------------------------------------------------
+// Binärformat /data.bin (frame_codec.h)
+//
+// Rundreise Encode → Decode mit dem Raster aus topology.h
+// und Zufallsinhalten, das Byte-Layout gegen die Tabelle
+// im Header, und dass Decode alles ablehnt, was nicht
+// Version 1 ist oder nicht vollständig vorliegt. Längere
+// Header (spätere Versionen mit angehängten Feldern)
+// werden übersprungen.
+// ----------------------------------------------------
+#include <unity.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "frame_codec.h"
+#include "topology.h"
+
+#define ROUNDS 1000
+
+static uint8_t s_buf[FRAME_CODEC_HEADER_LEN + 16 + 2 * FRAME_CODEC_MAX_PIXELS];
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static uint32_t s_rng = 1;
+static uint32_t rnd() {
+  s_rng ^= s_rng << 13;
+  s_rng ^= s_rng >> 17;
+  s_rng ^= s_rng << 5;
+  return s_rng;
+}
+
+static void randomFrame(BinaryFrame &f, uint8_t rows, uint8_t cols) {
+  memset(&f, 0, sizeof(f));
+  f.rows        = rows;
+  f.cols        = cols;
+  f.seq         = rnd();
+  f.timestampMs = rnd();
+  f.scanStartUs = rnd();
+  f.scanEndUs   = rnd();
+  f.valid       = ((uint64_t)rnd() << 32 | rnd()) & ((uint64_t)-1 >> (64 - f.pixels()));
+  for (uint16_t i = 0; i < f.pixels(); i++) f.value[i] = (uint16_t)rnd();
+}
+
+static void assertSameFrame(const BinaryFrame &a, const BinaryFrame &b) {
+  TEST_ASSERT_EQUAL(a.rows, b.rows);
+  TEST_ASSERT_EQUAL(a.cols, b.cols);
+  TEST_ASSERT_EQUAL_UINT32(a.seq, b.seq);
+  TEST_ASSERT_EQUAL_UINT32(a.timestampMs, b.timestampMs);
+  TEST_ASSERT_EQUAL_UINT32(a.scanStartUs, b.scanStartUs);
+  TEST_ASSERT_EQUAL_UINT32(a.scanEndUs, b.scanEndUs);
+  TEST_ASSERT_EQUAL_UINT64(a.valid, b.valid);
+  TEST_ASSERT_EQUAL_MEMORY(a.value, b.value, 2 * a.pixels());
+}
+
+// ----------------------------------------------------
+// Rundreise
+// ----------------------------------------------------
+void test_round_trip_board_grid(void) {
+  for (uint16_t round = 0; round < ROUNDS; round++) {
+    BinaryFrame in, out;
+    randomFrame(in, TOTAL_ROWS, NUM_SENSORS_PER_CHANNEL);
+    size_t len = frameCodecEncode(in, s_buf, sizeof(s_buf));
+    TEST_ASSERT_EQUAL(frameCodecSize(TOTAL_ROWS, NUM_SENSORS_PER_CHANNEL), len);
+    TEST_ASSERT_TRUE(frameCodecDecode(s_buf, len, out));
+    assertSameFrame(in, out);
+    for (uint8_t r = 0; r < in.rows; r++)
+      for (uint8_t c = 0; c < in.cols; c++) TEST_ASSERT_EQUAL(in.isValid(r, c), out.isValid(r, c));
+  }
+}
+
+void test_round_trip_any_grid(void) {
+  for (uint8_t rows = 1; rows <= FRAME_CODEC_MAX_PIXELS; rows++) {
+    for (uint8_t cols = 1; rows * cols <= FRAME_CODEC_MAX_PIXELS; cols++) {
+      BinaryFrame in, out;
+      randomFrame(in, rows, cols);
+      size_t len = frameCodecEncode(in, s_buf, sizeof(s_buf));
+      TEST_ASSERT_EQUAL(frameCodecSize(rows, cols), len);
+      TEST_ASSERT_TRUE(frameCodecDecode(s_buf, len, out));
+      assertSameFrame(in, out);
+    }
+  }
+}
+
+// ----------------------------------------------------
+// Layout
+// ----------------------------------------------------
+void test_layout_little_endian(void) {
+  BinaryFrame f;
+  memset(&f, 0, sizeof(f));
+  f.rows        = 2;
+  f.cols        = 1;
+  f.seq         = 0x04030201;
+  f.timestampMs = 0x08070605;
+  f.scanStartUs = 0x0C0B0A09;
+  f.scanEndUs   = 0x100F0E0D;
+  f.valid       = 0x1817161514131211ULL;
+  f.value[0]    = 0xB0A0;
+  f.value[1]    = 0xD0C0;
+
+  static const uint8_t expected[] = {
+    'F', 'P', 'X', 'F', FRAME_CODEC_VERSION, FRAME_CODEC_HEADER_LEN, 2, 1,
+    0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+    0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10,
+    0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18,
+    0xA0, 0xB0, 0xC0, 0xD0,
+  };
+  TEST_ASSERT_EQUAL(sizeof(expected), frameCodecEncode(f, s_buf, sizeof(s_buf)));
+  TEST_ASSERT_EQUAL_MEMORY(expected, s_buf, sizeof(expected));
+}
+
+// ----------------------------------------------------
+// Grenzen und Fehler
+// ----------------------------------------------------
+void test_encode_rejects_small_buffer_and_large_grid(void) {
+  BinaryFrame f;
+  randomFrame(f, TOTAL_ROWS, NUM_SENSORS_PER_CHANNEL);
+  const size_t len = frameCodecSize(f.rows, f.cols);
+  TEST_ASSERT_EQUAL(0, frameCodecEncode(f, s_buf, len - 1));
+  TEST_ASSERT_EQUAL(len, frameCodecEncode(f, s_buf, len));
+
+  f.rows = 13;
+  f.cols = 5;   // 65 Werte
+  TEST_ASSERT_EQUAL(0, frameCodecEncode(f, s_buf, sizeof(s_buf)));
+}
+
+void test_decode_rejects_malformed(void) {
+  BinaryFrame in, out;
+  randomFrame(in, TOTAL_ROWS, NUM_SENSORS_PER_CHANNEL);
+  const size_t len = frameCodecEncode(in, s_buf, sizeof(s_buf));
+
+  // Jede Kürzung
+  for (size_t n = 0; n < len; n++) TEST_ASSERT_FALSE(frameCodecDecode(s_buf, n, out));
+
+  uint8_t bad[sizeof(s_buf)];
+  memcpy(bad, s_buf, len);
+  bad[0] = 'X';
+  TEST_ASSERT_FALSE(frameCodecDecode(bad, len, out));
+
+  memcpy(bad, s_buf, len);
+  bad[4] = FRAME_CODEC_VERSION + 1;
+  TEST_ASSERT_FALSE(frameCodecDecode(bad, len, out));
+
+  memcpy(bad, s_buf, len);
+  bad[5] = FRAME_CODEC_HEADER_LEN - 1;
+  TEST_ASSERT_FALSE(frameCodecDecode(bad, len, out));
+
+  memcpy(bad, s_buf, len);
+  bad[6] = 13;
+  bad[7] = 5;
+  TEST_ASSERT_FALSE(frameCodecDecode(bad, sizeof(bad), out));
+}
+
+void test_decode_skips_longer_header(void) {
+  BinaryFrame in, out;
+  randomFrame(in, TOTAL_ROWS, NUM_SENSORS_PER_CHANNEL);
+  uint8_t plain[sizeof(s_buf)];
+  const size_t len = frameCodecEncode(in, plain, sizeof(plain));
+
+  // Acht angehängte Header-Bytes, die dieser Leser nicht kennt
+  const uint8_t extra = 8;
+  memcpy(s_buf, plain, FRAME_CODEC_HEADER_LEN);
+  memset(s_buf + FRAME_CODEC_HEADER_LEN, 0xEE, extra);
+  memcpy(s_buf + FRAME_CODEC_HEADER_LEN + extra, plain + FRAME_CODEC_HEADER_LEN, len - FRAME_CODEC_HEADER_LEN);
+  s_buf[5] = FRAME_CODEC_HEADER_LEN + extra;
+
+  TEST_ASSERT_FALSE(frameCodecDecode(s_buf, len + extra - 1, out));
+  TEST_ASSERT_TRUE(frameCodecDecode(s_buf, len + extra, out));
+  assertSameFrame(in, out);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_round_trip_board_grid);
+  RUN_TEST(test_round_trip_any_grid);
+  RUN_TEST(test_layout_little_endian);
+  RUN_TEST(test_encode_rejects_small_buffer_and_large_grid);
+  RUN_TEST(test_decode_rejects_malformed);
+  RUN_TEST(test_decode_skips_longer_header);
+  return UNITY_END();
+}
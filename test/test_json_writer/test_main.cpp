@@ -0,0 +1,205 @@
+// ----------------------------------------------------
+// JsonWriter (env:native)
+//
+// formatLux() muss byte-gleich mit dem bisherigen
+// String(lux, 1) sein, also mit dtostrf(lux, 3, 1) auf den
+// Float aus lux_from_raw(). Der Simulator bringt dtostrf
+// aus dem Kern mit; verglichen wird für alle Rohwerte, die
+// der Sensor liefern kann (Exponent 0..12).
+//
+// Dazu Aufbau, Überlauf und ein Durchsatzvergleich mit dem
+// bisherigen /data-Handler (String mit reserve(4000),
+// String(v, 1) je Wert). Der Host hat kein Arduino-String,
+// std::string steht dafür; String(float) holt sich wie im
+// Kern einen Puffer per new. Gezählt werden alle new.
+// ----------------------------------------------------
+#include <unity.h>
+
+#include <Arduino.h>
+#include <opt3001.h>
+
+#include <chrono>
+#include <new>
+#include <stdlib.h>
+#include <string>
+#include <string.h>
+
+#include "json_writer.h"
+#include "topology.h"
+
+#define BENCH_DOCS 20000
+
+// ----------------------------------------------------
+// Heap-Zähler
+// ----------------------------------------------------
+static size_t s_allocs = 0;
+
+static void *countedAlloc(size_t n) {
+  s_allocs++;
+  void *p = malloc(n ? n : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+void *operator new(size_t n) { return countedAlloc(n); }
+void *operator new[](size_t n) { return countedAlloc(n); }
+void operator delete(void *p) noexcept { free(p); }
+void operator delete[](void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+void operator delete[](void *p, size_t) noexcept { free(p); }
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ----------------------------------------------------
+// Formatierung
+// ----------------------------------------------------
+void test_format_lux_matches_dtostrf(void) {
+  uint32_t mismatches = 0;
+  char     first[64]  = "";
+  for (uint32_t raw = 0; raw < 0xD000; raw++) {
+    char expected[48], got[JSON_LUX_MAX_LEN];
+    dtostrf(opt3001::lux_from_raw(raw), 3, 1, expected);
+    size_t len = JsonWriter::formatLux(got, raw);
+    if (strcmp(expected, got) != 0 || len != strlen(expected)) {
+      if (!mismatches) snprintf(first, sizeof(first), "0x%04x: %.15s statt %.15s", (unsigned)raw, got, expected);
+      mismatches++;
+    }
+  }
+  TEST_ASSERT_EQUAL_STRING("", first);
+  TEST_ASSERT_EQUAL_UINT32(0, mismatches);
+}
+
+void test_format_lux_edges(void) {
+  char s[JSON_LUX_MAX_LEN];
+  TEST_ASSERT_EQUAL(3, JsonWriter::formatLux(s, 0x0000));
+  TEST_ASSERT_EQUAL_STRING("0.0", s);
+  JsonWriter::formatLux(s, 0x0005);   // 0.05 lx: Float knapp darüber
+  TEST_ASSERT_EQUAL_STRING("0.1", s);
+  JsonWriter::formatLux(s, 0xBFFF);   // Vollausschlag 83865.6 lx
+  TEST_ASSERT_EQUAL_STRING("83865.6", s);
+  TEST_ASSERT_TRUE(JsonWriter::formatLux(s, 0xFFFF) < JSON_LUX_MAX_LEN);
+}
+
+// ----------------------------------------------------
+// Aufbau
+// ----------------------------------------------------
+void test_nested_document(void) {
+  char buf[96];
+  JsonWriter w(buf, sizeof(buf));
+  w.beginObject()
+      .key("a").value((uint32_t)1)
+      .key("b").beginArray().value(true).null().lux(0x0123).endArray()
+      .key("c").value("x")
+      .endObject();
+  TEST_ASSERT_FALSE(w.overflow());
+  TEST_ASSERT_EQUAL_STRING("{\"a\":1,\"b\":[true,null,2.9],\"c\":\"x\"}", w.c_str());
+  TEST_ASSERT_EQUAL(strlen(buf), w.length());
+
+  w.reset();
+  w.beginArray().endArray();
+  TEST_ASSERT_EQUAL_STRING("[]", w.c_str());
+}
+
+void test_overflow_truncates_inside_buffer(void) {
+  char buf[16];
+  memset(buf, '#', sizeof(buf));
+  JsonWriter w(buf, 8);
+  w.beginArray().value((uint32_t)123456).value((uint32_t)7).endArray();
+  TEST_ASSERT_TRUE(w.overflow());
+  TEST_ASSERT_TRUE(w.length() < 8);
+  TEST_ASSERT_EQUAL(w.length(), strlen(buf));
+  for (size_t i = 8; i < sizeof(buf); i++) TEST_ASSERT_EQUAL('#', buf[i]);
+
+  w.reset();
+  TEST_ASSERT_FALSE(w.overflow());
+  TEST_ASSERT_EQUAL(0, w.length());
+}
+
+// ----------------------------------------------------
+// Durchsatz und Heap: /data mit allen Sensoren
+// ----------------------------------------------------
+static uint16_t s_raw[TOTAL_ROWS][NUM_SENSORS_PER_CHANNEL];
+
+static void fillRaw() {
+  for (uint8_t r = 0; r < TOTAL_ROWS; r++)
+    for (uint8_t c = 0; c < NUM_SENSORS_PER_CHANNEL; c++) {
+      uint16_t n = r * NUM_SENSORS_PER_CHANNEL + c;
+      s_raw[r][c] = (n % 12) << 12 | (n * 677 % 4096);
+    }
+}
+
+// Bisheriger Handler: String(v, 1) legt je Wert einen Puffer an
+static std::string legacyData() {
+  std::string json;
+  json.reserve(4000);
+  json += "[";
+  bool first = true;
+  for (int r = TOTAL_ROWS - 1; r >= 0; r--) {
+    for (uint8_t c = 0; c < NUM_SENSORS_PER_CHANNEL; c++) {
+      if (!first) json += ",";
+      first = false;
+      char *buf = new char[1 + 42];
+      dtostrf(opt3001::lux_from_raw(s_raw[r][c]), 3, 1, buf);
+      json += buf;
+      delete[] buf;
+    }
+  }
+  json += "]";
+  return json;
+}
+
+static char s_json[TOTAL_SENSORS * (JSON_LUX_MAX_LEN + 1) + 3];
+
+static size_t writerData(JsonWriter &w) {
+  w.reset();
+  w.beginArray();
+  for (int r = TOTAL_ROWS - 1; r >= 0; r--)
+    for (uint8_t c = 0; c < NUM_SENSORS_PER_CHANNEL; c++) w.lux(s_raw[r][c]);
+  w.endArray();
+  return w.length();
+}
+
+void test_throughput_and_allocations(void) {
+  fillRaw();
+  JsonWriter w(s_json, sizeof(s_json));
+  writerData(w);
+  TEST_ASSERT_FALSE(w.overflow());
+  std::string legacy = legacyData();
+  TEST_ASSERT_EQUAL_STRING(legacy.c_str(), w.c_str());
+
+  size_t bytes[2]  = {0, 0};
+  size_t allocs[2] = {0, 0};
+  double secs[2];
+  for (uint8_t writer = 0; writer < 2; writer++) {
+    size_t a0 = s_allocs;
+    auto   t0 = std::chrono::steady_clock::now();
+    for (uint32_t d = 0; d < BENCH_DOCS; d++) {
+      bytes[writer] += writer ? writerData(w) : legacyData().size();
+    }
+    secs[writer]   = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    allocs[writer] = s_allocs - a0;
+  }
+
+  char line[128];
+  snprintf(line, sizeof(line), "String:     %6.1f MB/s  %5.1f new je Dokument",
+           bytes[0] / secs[0] / 1e6, (double)allocs[0] / BENCH_DOCS);
+  TEST_MESSAGE(line);
+  snprintf(line, sizeof(line), "JsonWriter: %6.1f MB/s  %5.1f new je Dokument",
+           bytes[1] / secs[1] / 1e6, (double)allocs[1] / BENCH_DOCS);
+  TEST_MESSAGE(line);
+
+  // Durchsatz nur gemeldet (hängt vom Host ab), Heap-Zugriffe geprüft
+  TEST_ASSERT_EQUAL_UINT32(0, allocs[1]);
+  TEST_ASSERT_TRUE(allocs[0] >= (size_t)BENCH_DOCS * (TOTAL_SENSORS + 1));
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_format_lux_matches_dtostrf);
+  RUN_TEST(test_format_lux_edges);
+  RUN_TEST(test_nested_document);
+  RUN_TEST(test_overflow_truncates_inside_buffer);
+  RUN_TEST(test_throughput_and_allocations);
+  return UNITY_END();
+}
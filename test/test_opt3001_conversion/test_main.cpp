@@ -0,0 +1,93 @@
+// ----------------------------------------------------
+// Umrechnung des Result-Registers ohne pow()
+//
+// Alle 65536 Registerwerte gegen die ursprüngliche
+// Rechnung mantissa * (0.01 * pow(2, exponent)): die
+// Float-Werte bitgleich, die Centilux exakt. Dazu ein
+// Mikrobenchmark beider Wege auf dem Host, nur als
+// Meldung (Trend; auf dem ESP32 fällt der double-pow()
+// stärker ins Gewicht).
+// ----------------------------------------------------
+#include <unity.h>
+
+#include <Arduino.h>
+#include <opt3001.h>
+
+#include <chrono>
+#include <math.h>
+#include <string.h>
+
+#define BENCH_ROUNDS 200
+
+// lux_read() vor der Tabelle
+static float luxPow(uint16_t raw) {
+  uint16_t mantissa = raw & 0x0FFF;
+  uint16_t exponent = (raw & 0xF000) >> 12;
+  return mantissa * (0.01 * pow(2, exponent));
+}
+
+static uint32_t floatBits(float f) {
+  uint32_t u;
+  memcpy(&u, &f, sizeof(u));
+  return u;
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_lux_bit_exact_for_all_registers(void) {
+  uint32_t mismatches = 0;
+  for (uint32_t raw = 0; raw <= 0xFFFF; raw++) {
+    if (floatBits(opt3001::lux_from_raw(raw)) != floatBits(luxPow(raw))) mismatches++;
+  }
+  TEST_ASSERT_EQUAL_UINT32(0, mismatches);
+}
+
+void test_centilux_exact_for_all_registers(void) {
+  for (uint32_t raw = 0; raw <= 0xFFFF; raw++) {
+    uint32_t mantissa = raw & 0x0FFF;
+    uint32_t exponent = raw >> 12;
+    uint32_t expected = (uint32_t)(mantissa * pow(2, exponent) + 0.5);
+    TEST_ASSERT_EQUAL_UINT32(expected, opt3001::centilux_from_raw(raw));
+  }
+  // Datenblatt: Vollausschlag 83865.60 lx
+  TEST_ASSERT_EQUAL_UINT32(8386560, opt3001::centilux_from_raw(0xBFFF));
+  TEST_ASSERT_EQUAL_UINT32(4095u << 15, opt3001::centilux_from_raw(0xFFFF));
+}
+
+// ----------------------------------------------------
+// Mikrobenchmark
+// ----------------------------------------------------
+template <typename F>
+static double nsPerValue(F convert) {
+  volatile float sink = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  for (uint16_t round = 0; round < BENCH_ROUNDS; round++) {
+    for (uint32_t raw = 0; raw <= 0xFFFF; raw++) sink = sink + convert((uint16_t)raw);
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  (void)sink;
+  return std::chrono::duration<double, std::nano>(t1 - t0).count() / (BENCH_ROUNDS * 65536.0);
+}
+
+static float luxTable(uint16_t raw) { return opt3001::lux_from_raw(raw); }
+static float luxCenti(uint16_t raw) { return (float)opt3001::centilux_from_raw(raw); }
+
+void test_conversion_benchmark(void) {
+  double tPow   = nsPerValue(luxPow);
+  double tTable = nsPerValue(luxTable);
+  double tCenti = nsPerValue(luxCenti);
+
+  char line[128];
+  snprintf(line, sizeof(line), "pow(): %.2f ns  Tabelle+FMA: %.2f ns  Centilux: %.2f ns je Wert",
+           tPow, tTable, tCenti);
+  TEST_MESSAGE(line);   // nur berichtet: Laufzeiten hängen vom Host ab
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_lux_bit_exact_for_all_registers);
+  RUN_TEST(test_centilux_exact_for_all_registers);
+  RUN_TEST(test_conversion_benchmark);
+  return UNITY_END();
+}
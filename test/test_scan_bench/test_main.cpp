@@ -0,0 +1,284 @@
+// ----------------------------------------------------
+// Kosten je Frame: alte Scan-Schleife vs. Opt3001Array
+//
+// Die alte Schleife (updateLuxMatrix() in main.cpp vor der
+// Sensortabelle) schaltet jeden Kanal mit fester Wartezeit
+// von 500 µs, bindet dasselbe Treiberobjekt je Sensor per
+// setup() neu (Pointer jedes Mal neu schreiben) und liest
+// das Result ohne Rücksicht auf CRF, Durchlauf um Durchlauf.
+// Opt3001Array läuft über die beim Boot gebaute Tabelle,
+// lässt den Pointer auf Result und liest jede Wandlung
+// genau einmal, im Wandlungs-Raster ohne CRF-Abfrage.
+//
+// Beide laufen dieselbe simulierte Zeit; ein Frame ist ein
+// Durchlauf (alt) bzw. eine Wandlungszeit (neu). Ausgegeben
+// werden Host-Zyklen in der Scan-Funktion (inkl. Simulator,
+// daher nur als Trend), Buszeit und Transaktionen je Frame
+// auf dem simulierten 100-kHz-Bus und gelesene Results je
+// Wandlung. Gemessen wird der neue Scan erst, wenn das
+// Raster nach configure() eingeschwungen ist (wie im
+// Betrieb). Geprüft wird, was deterministisch ist: weniger
+// Treiberaufrufe und Buszeit, keine doppelt gelesenen
+// Wandlungen.
+// ----------------------------------------------------
+#include <unity.h>
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <Preferences.h>
+#include <opt3001.h>
+
+#include <chrono>
+
+#include <sim_board.h>
+#include "opt3001_array.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+static inline uint64_t cycles() { return __rdtsc(); }
+#else
+static inline uint64_t cycles() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+#endif
+
+#define BENCH_SPAN_MS   2000
+#define BENCH_SETTLE_MS 10000   // neuer Scan: Raster einschwingen
+
+struct FrameCost {
+  uint32_t frames;
+  uint64_t hostCycles;     // je Frame
+  uint64_t busUs;          // je Frame
+  uint32_t transactions;   // je Frame
+  uint32_t bytes;          // je Frame (Adressen und Daten)
+  double   readsPerConversion;
+};
+
+static Opt3001Array s_array;
+static opt3001      s_sensor;
+static float        s_luxMatrix[TOTAL_ROWS][NUM_SENSORS_PER_CHANNEL];
+
+void setUp(void) {
+  sim::reset();
+  sim::erasePreferences();
+}
+
+void tearDown(void) {
+  Wire.end();
+}
+
+static void boot(SimBoard &board) {
+  board.setLux(250.0);
+  Wire.begin(I2C0_SDA, I2C0_SCL, I2C_FREQ_HZ);
+  s_array.begin(Wire, 0);
+  s_array.loadMap();
+  s_array.reset();
+  s_array.configure(OPT3001_CONVERSION_TIME_100MS, true);
+  s_array.calibrateSettle();
+}
+
+// Results und Wandlungen aller simulierten Sensoren
+static void boardCounters(SimBoard &board, uint32_t &reads, uint32_t &conversions) {
+  reads = conversions = 0;
+  for (uint8_t m = 0; m < NUM_MUXES; m++)
+    for (uint8_t ch = 0; ch < MUX_CHANNEL_COUNT[m]; ch++)
+      for (uint8_t k = 0; k < NUM_SENSORS_PER_CHANNEL; k++) {
+        reads       += board.sensor(m, ch, k).resultReads();
+        conversions += board.sensor(m, ch, k).conversions();
+      }
+}
+
+// ----------------------------------------------------
+// Alte Scan-Schleife
+// ----------------------------------------------------
+static void legacySelect(uint8_t mux, uint8_t value) {
+  Wire.beginTransmission(MUX_ADDR[mux]);
+  Wire.write(value);
+  Wire.endTransmission();
+}
+
+static void legacyFrame() {
+  uint8_t row = 0;
+  for (uint8_t m = 0; m < NUM_MUXES; m++) {
+    for (uint8_t ch = 0; ch < MUX_CHANNEL_COUNT[m]; ch++) {
+      if (row >= TOTAL_ROWS) break;
+      legacySelect(m, 1 << ch);
+      delayMicroseconds(500);
+      for (uint8_t i = 0; i < NUM_SENSORS_PER_CHANNEL; i++) {
+        float lux = NAN;
+        if (s_sensor.setup(Wire, SENSOR_ADDR[i]) == 0) {
+          if (s_sensor.lux_read(&lux) != 0) lux = NAN;
+        }
+        s_luxMatrix[row][i] = lux;
+      }
+      row++;
+    }
+    legacySelect(m, 0x00);
+  }
+}
+
+// ----------------------------------------------------
+// Messung über BENCH_SPAN_MS simulierte Zeit
+// ----------------------------------------------------
+static FrameCost measure(SimBoard &board, bool legacy) {
+  FrameCost cost = {};
+  delay(100);   // eingeschwungen: alle Sensoren mit fertiger Wandlung
+  if (!legacy) {
+    // wie im Firmware-Start: configure() verankert das Raster,
+    // danach läuft der Scan ein, bevor gemessen wird
+    s_array.configure(OPT3001_CONVERSION_TIME_100MS, true);
+    const unsigned long settled = millis() + BENCH_SETTLE_MS;
+    while ((long)(settled - millis()) > 0) {
+      s_array.service(micros());
+      delay(1);
+    }
+  }
+
+  uint32_t reads0, conversions0;
+  boardCounters(board, reads0, conversions0);
+  sim::bus(0).resetStats();
+
+  const unsigned long end = millis() + BENCH_SPAN_MS;
+  while ((long)(end - millis()) > 0) {
+    uint64_t c0 = cycles();
+    if (legacy) {
+      legacyFrame();
+      cost.frames++;
+    } else {
+      s_array.service(micros());
+    }
+    cost.hostCycles += cycles() - c0;
+    if (!legacy) delay(1);
+  }
+  if (!legacy) cost.frames = BENCH_SPAN_MS * 1000 / s_array.conversionUs();
+
+  uint32_t reads, conversions;
+  boardCounters(board, reads, conversions);
+  cost.readsPerConversion = (double)(reads - reads0) / (conversions - conversions0);
+  cost.hostCycles  /= cost.frames;
+  cost.busUs        = sim::bus(0).stats().busyNs / 1000 / cost.frames;
+  cost.transactions = sim::bus(0).stats().transactions / cost.frames;
+  cost.bytes        = sim::bus(0).stats().bytes / cost.frames;
+  return cost;
+}
+
+static void report(const char *name, const FrameCost &c) {
+  char line[192];
+  snprintf(line, sizeof(line),
+           "%-8s %10llu Zyklen (Host)  %6llu us Bus  %4u Transaktionen  %4u Bytes  je Frame,  %.2f Results/Wandlung",
+           name, (unsigned long long)c.hostCycles, (unsigned long long)c.busUs, (unsigned)c.transactions,
+           (unsigned)c.bytes, c.readsPerConversion);
+  TEST_MESSAGE(line);
+}
+
+void test_frame_cost_before_after(void) {
+  SimBoard board;
+  boot(board);
+
+  FrameCost before = measure(board, true);
+  for (uint8_t r = 0; r < TOTAL_ROWS; r++)
+    for (uint8_t c = 0; c < NUM_SENSORS_PER_CHANNEL; c++) TEST_ASSERT_FLOAT_WITHIN(0.5, 250.0, s_luxMatrix[r][c]);
+
+  FrameCost after = measure(board, false);
+  for (uint8_t i = 0; i < s_array.size(); i++) TEST_ASSERT_EQUAL(0, s_array.slot(i).status);
+
+  report("vorher", before);
+  report("nachher", after);
+
+  // Alt: Mux je Kanal, Pointer+Result je Sensor, jede Wandlung mehrfach.
+  // Neu: je Wandlung ein Result, Config nur zum Nachverankern
+  TEST_ASSERT_LESS_THAN_UINT32(before.transactions, after.transactions);
+  TEST_ASSERT_LESS_THAN_UINT32((uint32_t)before.busUs, (uint32_t)after.busUs);
+  TEST_ASSERT_TRUE(before.readsPerConversion > 1.5);
+  TEST_ASSERT_DOUBLE_WITHIN(0.02, 1.0, after.readsPerConversion);
+}
+
+// ----------------------------------------------------
+// Nur die Treiberbindung: gleiche Zugriffe (Result je
+// Sensor, Mux je Kanal), einmal mit einem je Sensor neu
+// gebundenen Objekt, einmal mit einem Treiber je Sensor,
+// einmal beim Boot gebunden. setup() verwirft den Register-
+// Pointer, jeder Read kostet dann den Pointer-Schreibzugriff
+// (5 statt 3 Bytes auf dem Bus).
+// ----------------------------------------------------
+static opt3001 s_handles[TOTAL_SENSORS];
+
+static void tableFrame() {
+  uint8_t n = 0;
+  for (uint8_t m = 0; m < NUM_MUXES; m++) {
+    for (uint8_t ch = 0; ch < MUX_CHANNEL_COUNT[m]; ch++) {
+      legacySelect(m, 1 << ch);
+      for (uint8_t i = 0; i < NUM_SENSORS_PER_CHANNEL; i++, n++) {
+        float lux = NAN;
+        if (s_handles[n].lux_read(&lux) != 0) lux = NAN;
+        s_luxMatrix[n / NUM_SENSORS_PER_CHANNEL][i] = lux;
+      }
+    }
+    legacySelect(m, 0x00);
+  }
+}
+
+static void rebindFrame() {
+  uint8_t row = 0;
+  for (uint8_t m = 0; m < NUM_MUXES; m++) {
+    for (uint8_t ch = 0; ch < MUX_CHANNEL_COUNT[m]; ch++, row++) {
+      legacySelect(m, 1 << ch);
+      for (uint8_t i = 0; i < NUM_SENSORS_PER_CHANNEL; i++) {
+        float lux = NAN;
+        if (s_sensor.setup(Wire, SENSOR_ADDR[i]) == 0 && s_sensor.lux_read(&lux) != 0) lux = NAN;
+        s_luxMatrix[row][i] = lux;
+      }
+    }
+    legacySelect(m, 0x00);
+  }
+}
+
+void test_bound_handles_skip_pointer_writes(void) {
+  SimBoard board;
+  boot(board);
+
+  uint8_t n = 0;
+  for (uint8_t m = 0; m < NUM_MUXES; m++) {
+    for (uint8_t ch = 0; ch < MUX_CHANNEL_COUNT[m]; ch++) {
+      legacySelect(m, 1 << ch);
+      for (uint8_t i = 0; i < NUM_SENSORS_PER_CHANNEL; i++, n++) {
+        TEST_ASSERT_EQUAL(0, s_handles[n].setup(Wire, SENSOR_ADDR[i]));
+        TEST_ASSERT_EQUAL(0, s_handles[n].result_streaming_enable());
+      }
+    }
+    legacySelect(m, 0x00);
+  }
+
+  const uint8_t FRAMES = 20;
+  FrameCost cost[2] = {};
+  for (uint8_t table = 0; table < 2; table++) {
+    tableFrame();   // Pointer aller Sensoren auf Result
+    sim::bus(0).resetStats();
+    for (uint8_t f = 0; f < FRAMES; f++) {
+      uint64_t c0 = cycles();
+      table ? tableFrame() : rebindFrame();
+      cost[table].hostCycles += cycles() - c0;
+    }
+    cost[table].frames       = FRAMES;
+    cost[table].hostCycles  /= FRAMES;
+    cost[table].busUs        = sim::bus(0).stats().busyNs / 1000 / FRAMES;
+    cost[table].transactions = sim::bus(0).stats().transactions / FRAMES;
+    cost[table].bytes        = sim::bus(0).stats().bytes / FRAMES;
+    cost[table].readsPerConversion = 1;
+  }
+  report("setup()", cost[0]);
+  report("Tabelle", cost[1]);
+
+  const uint32_t muxBytes = 2 * (TOTAL_ROWS + NUM_MUXES);
+  TEST_ASSERT_EQUAL_UINT32(muxBytes + TOTAL_SENSORS * 5, cost[0].bytes);
+  TEST_ASSERT_EQUAL_UINT32(muxBytes + TOTAL_SENSORS * 3, cost[1].bytes);
+  TEST_ASSERT_LESS_THAN_UINT32(cost[0].busUs, cost[1].busUs);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_frame_cost_before_after);
+  RUN_TEST(test_bound_handles_skip_pointer_writes);
+  return UNITY_END();
+}
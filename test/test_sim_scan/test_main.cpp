@@ -0,0 +1,480 @@
+// ----------------------------------------------------
+// Scan gegen den simulierten Bus (env:native)
+//
+// Board wie topology.h: drei TCA9548A, je Kanal drei
+// OPT3001. Geprüft wird, was auf dem Gerät nur mit Logic-
+// Analyzer sichtbar ist: Buszeit je Byte und Taktrate,
+// Kollisionen beim Broadcast, NACK fehlender Sensoren,
+// CRF-Timing und dass jede Wandlung genau einmal gelesen
+// wird.
+// ----------------------------------------------------
+#include <unity.h>
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <Preferences.h>
+#include <opt3001.h>
+
+#include <sim_board.h>
+#include "opt3001_array.h"
+
+// Config: automatischer Messbereich, 100 ms, Continuous, Latch
+#define CONFIG_CONTINUOUS 0xC410
+#define CONFIG_SINGLESHOT 0xC210
+#define CONFIG_CRF        (1 << 7)
+#define CONFIG_MODE(c)    (((c) >> 9) & 3)
+
+static Opt3001Array s_array;
+
+void setUp(void) {
+  sim::reset();
+  sim::erasePreferences();
+}
+
+void tearDown(void) {
+  Wire.end();
+}
+
+// Boot wie in main.cpp
+static void boot(Opt3001Array &array, uint32_t hz = I2C_FREQ_HZ) {
+  Wire.begin(I2C0_SDA, I2C0_SCL, hz);
+  array.begin(Wire, 0);
+  array.loadMap();
+  array.reset();
+  array.configure(OPT3001_CONVERSION_TIME_100MS, true);
+  array.calibrateSettle();
+}
+
+static uint8_t countPresent(const Opt3001Array &array) {
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < array.size(); i++) n += array.slot(i).present;
+  return n;
+}
+
+// Platz eines Sensors in der Tabelle
+static int slotIndex(const Opt3001Array &array, uint8_t mux, uint8_t ch, uint8_t col) {
+  for (uint8_t i = 0; i < array.size(); i++) {
+    const Opt3001Slot &s = array.slot(i);
+    if (s.mux == mux && s.channel == ch && s.col == col) return i;
+  }
+  return -1;
+}
+
+// service() im Millisekundentakt über 'ms' simulierte Zeit
+static void run(Opt3001Array &array, uint32_t ms) {
+  const unsigned long end = millis() + ms;
+  while ((long)(end - millis()) > 0) {
+    array.service(micros());
+    delay(1);
+  }
+}
+
+// ----------------------------------------------------
+// Bus-Timing
+// ----------------------------------------------------
+// Register lesen über TwoWire: START + Adresse, Pointer,
+// Repeated START + Adresse, zwei Datenbytes, STOP
+// = 10 + 9 + 10 + 18 + 1 = 48 Takte
+static void checkRegisterReadTime(uint32_t hz) {
+  sim::reset();
+  SimOpt3001 dev(0x44);
+  sim::bus(0).attach(dev);
+  Wire.begin(I2C0_SDA, I2C0_SCL, hz);
+
+  opt3001 drv;
+  TEST_ASSERT_EQUAL(0, drv.setup(Wire, 0x44));
+  uint16_t id = 0;
+  uint64_t t0 = sim::nowNs();
+  TEST_ASSERT_EQUAL(0, drv.register_read(OPT3001_REGISTER_MANUID, &id));
+  TEST_ASSERT_EQUAL_HEX16(SIM_OPT3001_MANUID, id);
+  TEST_ASSERT_EQUAL_UINT64(48ULL * 1000000000ULL / hz, sim::nowNs() - t0);
+  TEST_ASSERT_EQUAL_UINT32(5, sim::bus(0).stats().bytes);   // Adresse, Pointer, Adresse, 2 Daten
+  Wire.end();
+}
+
+void test_register_read_time_100k(void) { checkRegisterReadTime(100000); }
+void test_register_read_time_400k(void) { checkRegisterReadTime(400000); }
+void test_register_read_time_1m(void)   { checkRegisterReadTime(1000000); }
+
+// Der TCA9548A kann höchstens 400 kHz: bei 1 MHz findet
+// die Discovery keinen Mux und damit keinen Sensor
+void test_mux_rejects_1m(void) {
+  SimBoard board;
+  boot(s_array, 1000000);
+  TEST_ASSERT_EQUAL_UINT8(0, s_array.sensorMap().muxAck);
+  TEST_ASSERT_EQUAL_UINT8(0, countPresent(s_array));
+}
+
+// Ein kompletter Durchlauf kostet bei 400 kHz ein Viertel
+// der Buszeit von 100 kHz (ohne Treiber-Overhead)
+void test_scan_time_scales_with_clock(void) {
+  uint64_t busy[2];
+  const uint32_t hz[2] = { 100000, 400000 };
+  for (uint8_t i = 0; i < 2; i++) {
+    sim::reset();
+    SimBoard board;
+    boot(s_array, hz[i]);
+    delay(100);   // alle Wandlungen fertig
+    sim::bus(0).resetStats();
+    s_array.service(micros());
+    busy[i] = sim::bus(0).stats().busyNs;
+    Wire.end();
+  }
+  TEST_ASSERT_EQUAL_UINT64(busy[0], busy[1] * 4);
+}
+
+// ----------------------------------------------------
+// Discovery, Kollisionen, NACK
+// ----------------------------------------------------
+void test_discovery_maps_every_sensor(void) {
+  SimBoard board;
+  boot(s_array);
+  TEST_ASSERT_EQUAL_UINT8(TOTAL_SENSORS, s_array.size());
+  TEST_ASSERT_EQUAL_UINT8(TOTAL_SENSORS, countPresent(s_array));
+  TEST_ASSERT_TRUE(s_array.mapConsistent());
+  for (uint8_t m = 0; m < NUM_MUXES; m++) {
+    TEST_ASSERT_TRUE(s_array.sensorMap().muxAck & (1 << (MUX_ADDR[m] - SENSOR_MAP_MUX_BASE)));
+  }
+
+  // Zweiter Boot: Karte kommt aus dem NVS, keine Discovery
+  static Opt3001Array again;
+  again.begin(Wire, 0);
+  TEST_ASSERT_TRUE(again.loadMap());
+}
+
+// Broadcast: alle Kanäle eines Muxes offen, je Adresse
+// quittieren alle Sensoren gemeinsam
+void test_broadcast_collides_by_design(void) {
+  SimBoard board;
+  Wire.begin(I2C0_SDA, I2C0_SCL, I2C_FREQ_HZ);
+  s_array.begin(Wire, 0);
+
+  sim::bus(0).resetStats();
+  TEST_ASSERT_EQUAL_UINT8(NUM_MUXES * NUM_SENSORS_PER_CHANNEL,
+                          s_array.broadcastWrite(OPT3001_REGISTER_CONFIG, CONFIG_CONTINUOUS));
+  TEST_ASSERT_EQUAL_UINT32(NUM_MUXES * NUM_SENSORS_PER_CHANNEL, sim::bus(0).stats().collisions);
+
+  for (uint8_t m = 0; m < NUM_MUXES; m++) {
+    TEST_ASSERT_EQUAL_HEX8(0, board.mux(m).control());   // danach wieder alle zu
+    for (uint8_t ch = 0; ch < MUX_CHANNEL_COUNT[m]; ch++)
+      for (uint8_t k = 0; k < NUM_SENSORS_PER_CHANNEL; k++)
+        TEST_ASSERT_EQUAL(2, CONFIG_MODE(board.sensor(m, ch, k).config()));
+  }
+}
+
+// Lesen bei Kollision: Open-Drain verundet die Antworten
+void test_colliding_read_is_wired_and(void) {
+  SimOpt3001 a(0x44), b(0x44);
+  sim::bus(0).attach(a);
+  sim::bus(0).attach(b);
+  a.setLux(0x0F0 / 100.0);
+  b.setLux(0x00F / 100.0);
+  Wire.begin(I2C0_SDA, I2C0_SCL, I2C_FREQ_HZ);
+
+  opt3001 drv;
+  drv.setup(Wire, 0x44);
+  TEST_ASSERT_EQUAL(0, drv.register_write(OPT3001_REGISTER_CONFIG, CONFIG_CONTINUOUS));
+  delay(100);
+  uint16_t raw = 0xFFFF;
+  TEST_ASSERT_EQUAL(0, drv.register_read(OPT3001_REGISTER_RESULT, &raw));
+  TEST_ASSERT_EQUAL_HEX16(0x0000, raw);
+  TEST_ASSERT_GREATER_THAN_UINT32(0, sim::bus(0).stats().collisions);
+}
+
+void test_missing_sensor_nacks_then_hotplugs(void) {
+  SimBoard board;
+  board.sensor(1, 2, 1).setPresent(false);
+  boot(s_array);
+
+  TEST_ASSERT_EQUAL_UINT8(TOTAL_SENSORS - 1, countPresent(s_array));
+  int i = slotIndex(s_array, 1, 2, 1);
+  TEST_ASSERT_TRUE(i >= 0);
+  TEST_ASSERT_FALSE(s_array.slot(i).mapped);
+  TEST_ASSERT_FALSE(s_array.slot(i).present);
+
+  // Leerer Platz kostet im Betrieb keinen Zugriff
+  sim::bus(0).resetStats();
+  run(s_array, 200);
+  TEST_ASSERT_EQUAL_UINT32(0, sim::bus(0).stats().nacks);
+
+  // Einstecken: die Hot-Plug-Probe nimmt ihn auf
+  uint32_t before = s_array.hotplugged();
+  board.sensor(1, 2, 1).setPresent(true);
+  TEST_ASSERT_EQUAL_UINT8(1, s_array.probeEmpty(1000000));
+  TEST_ASSERT_EQUAL_UINT32(before + 1, s_array.hotplugged());
+  TEST_ASSERT_TRUE(s_array.slot(i).present);
+  TEST_ASSERT_GREATER_OR_EQUAL(2, CONFIG_MODE(board.sensor(1, 2, 1).config()));   // 10/11: Continuous
+}
+
+// Ein Sensor, der ausfällt, wird nach HEALTH_SUSPECT_LIMIT
+// Fehlern nur noch mit Backoff angesprochen
+void test_failed_sensor_backs_off(void) {
+  SimBoard board;
+  boot(s_array);
+  int i = slotIndex(s_array, 0, 0, 0);
+  board.sensor(0, 0, 0).setPresent(false);
+
+  run(s_array, 1000);
+  TEST_ASSERT_EQUAL_UINT8(HEALTH_FAILED, s_array.slot(i).health);
+
+  // Die übrigen Sensoren des Kanals laufen weiter
+  TEST_ASSERT_EQUAL_UINT8(HEALTH_OK, s_array.slot(i + 1).health);
+  TEST_ASSERT_EQUAL(0, s_array.slot(i + 1).status);
+}
+
+// ----------------------------------------------------
+// Mux-Settle
+// ----------------------------------------------------
+// Das Adressbyte nach dem Umschalten dauert bei 100 kHz
+// schon 100 µs; ein Kanal, der 150 µs braucht, landet auf
+// der Leiterstufe 50 µs, alle anderen bei 0
+void test_settle_calibration_finds_slow_channel(void) {
+  SimBoard board;
+  board.mux(0).setSettleUs(3, 150);
+  boot(s_array);
+
+  TEST_ASSERT_EQUAL_UINT16(50, s_array.mux().settleUs(0, 3));
+  TEST_ASSERT_EQUAL_UINT16(0, s_array.mux().settleUs(0, 2));
+  TEST_ASSERT_EQUAL_UINT16(0, s_array.mux().settleUs(1, 3));
+}
+
+// ----------------------------------------------------
+// CRF-Timing
+// ----------------------------------------------------
+void test_crf_follows_conversion_time(void) {
+  SimOpt3001 dev(0x44);
+  sim::bus(0).attach(dev);
+  dev.setLux(123.45);
+  dev.setOscillator(1.1);   // 10 % langsam: 110 ms
+  Wire.begin(I2C0_SDA, I2C0_SCL, I2C_FREQ_HZ);
+
+  opt3001 drv;
+  drv.setup(Wire, 0x44);
+  TEST_ASSERT_EQUAL(0, drv.register_write(OPT3001_REGISTER_CONFIG, CONFIG_CONTINUOUS));
+  const uint64_t t0 = sim::nowNs();
+
+  uint16_t config;
+  sim::advanceNs(109000000ULL - (sim::nowNs() - t0));
+  TEST_ASSERT_EQUAL(0, drv.register_read(OPT3001_REGISTER_CONFIG, &config));
+  TEST_ASSERT_FALSE(config & CONFIG_CRF);
+
+  sim::advanceNs(110000000ULL - (sim::nowNs() - t0));
+  TEST_ASSERT_EQUAL(0, drv.register_read(OPT3001_REGISTER_CONFIG, &config));
+  TEST_ASSERT_TRUE(config & CONFIG_CRF);
+  // Lesen der Config löscht CRF
+  TEST_ASSERT_EQUAL(0, drv.register_read(OPT3001_REGISTER_CONFIG, &config));
+  TEST_ASSERT_FALSE(config & CONFIG_CRF);
+
+  uint16_t raw;
+  TEST_ASSERT_EQUAL(0, drv.register_read(OPT3001_REGISTER_RESULT, &raw));
+  TEST_ASSERT_EQUAL_HEX16(SimOpt3001::encode(123.45, 12), raw);
+  TEST_ASSERT_UINT32_WITHIN(4, 12345, opt3001::centilux_from_raw(raw));   // Exponent 2: Schritt 4
+}
+
+void test_singleshot_stops_after_one_conversion(void) {
+  SimOpt3001 dev(0x44);
+  sim::bus(0).attach(dev);
+  Wire.begin(I2C0_SDA, I2C0_SCL, I2C_FREQ_HZ);
+
+  opt3001 drv;
+  drv.setup(Wire, 0x44);
+  TEST_ASSERT_EQUAL(0, drv.register_write(OPT3001_REGISTER_CONFIG, CONFIG_SINGLESHOT));
+  delay(500);
+  TEST_ASSERT_EQUAL_UINT32(1, dev.conversions());
+  TEST_ASSERT_EQUAL(0, CONFIG_MODE(dev.config()));
+  TEST_ASSERT_TRUE(dev.config() & CONFIG_CRF);
+}
+
+// Über eine Sekunde: jeder Sensor wandelt zehnmal und
+// jede Wandlung wird genau einmal gelesen; ein Result ohne
+// vorher gesetztes CRF gibt es nicht
+void test_every_conversion_read_once(void) {
+  SimBoard board;
+  board.setLux(321.0);
+  boot(s_array);
+
+  for (uint8_t m = 0; m < NUM_MUXES; m++)
+    for (uint8_t ch = 0; ch < MUX_CHANNEL_COUNT[m]; ch++)
+      for (uint8_t k = 0; k < NUM_SENSORS_PER_CHANNEL; k++) {
+        SimOpt3001 &s = board.sensor(m, ch, k);
+        s.setOscillator(0.95 + 0.002 * (m * 24 + ch * 3 + k));   // Phasen laufen auseinander
+      }
+
+  uint32_t reads[NUM_MUXES][SIM_TCA9548A_CHANNELS][NUM_SENSORS_PER_CHANNEL];
+  uint32_t convs[NUM_MUXES][SIM_TCA9548A_CHANNELS][NUM_SENSORS_PER_CHANNEL];
+  for (uint8_t m = 0; m < NUM_MUXES; m++)
+    for (uint8_t ch = 0; ch < MUX_CHANNEL_COUNT[m]; ch++)
+      for (uint8_t k = 0; k < NUM_SENSORS_PER_CHANNEL; k++) {
+        reads[m][ch][k] = board.sensor(m, ch, k).resultReads();
+        convs[m][ch][k] = board.sensor(m, ch, k).conversions();
+      }
+
+  sim::bus(0).resetStats();
+  run(s_array, 1000);
+
+  for (uint8_t m = 0; m < NUM_MUXES; m++)
+    for (uint8_t ch = 0; ch < MUX_CHANNEL_COUNT[m]; ch++)
+      for (uint8_t k = 0; k < NUM_SENSORS_PER_CHANNEL; k++) {
+        SimOpt3001 &s = board.sensor(m, ch, k);
+        uint32_t conversions = s.conversions() - convs[m][ch][k];
+        uint32_t read        = s.resultReads() - reads[m][ch][k];
+        TEST_ASSERT_GREATER_OR_EQUAL_UINT32(9, conversions);
+        TEST_ASSERT_UINT32_WITHIN(1, conversions, read);
+      }
+
+  for (uint8_t i = 0; i < s_array.size(); i++) {
+    TEST_ASSERT_EQUAL(0, s_array.slot(i).status);
+    TEST_ASSERT_EQUAL_HEX16(SimOpt3001::encode(321.0, 12), s_array.slot(i).raw);
+  }
+  TEST_ASSERT_EQUAL_UINT32(0, sim::bus(0).stats().collisions);
+}
+
+// Eingeschwungen liest der Scan im Wandlungs-Raster nur das
+// Result; die Config (CRF) nur noch zum Nachverankern. Die
+// Oszillatoren driften dabei langsam (0.02 % je Wandlung,
+// jeder Sensor aus eigener Phase): keine Wandlung wird
+// doppelt gelesen (seit dem Start nie mehr Reads als
+// Wandlungen), im Fenster höchstens eine Wandlung Versatz.
+void test_grid_reads_result_only_under_drift(void) {
+  SimBoard board;
+  board.setLux(321.0);
+  boot(s_array);
+
+  double osc[TOTAL_SENSORS];
+  for (uint8_t i = 0; i < s_array.size(); i++) {
+    const Opt3001Slot &slot = s_array.slot(i);
+    osc[i] = 0.93 + 0.0025 * i;
+    board.sensor(slot.mux, slot.channel, slot.col).setOscillator(osc[i]);
+  }
+  run(s_array, 3000);   // Raster verankern
+
+  uint32_t reads[TOTAL_SENSORS], convs[TOTAL_SENSORS], configs = 0, results = 0;
+  for (uint8_t i = 0; i < s_array.size(); i++) {
+    const Opt3001Slot &slot = s_array.slot(i);
+    SimOpt3001 &dev = board.sensor(slot.mux, slot.channel, slot.col);
+    reads[i] = dev.resultReads();
+    convs[i] = dev.conversions();
+    configs -= dev.configReads();
+  }
+
+  for (uint8_t step = 0; step < 30; step++) {
+    for (uint8_t i = 0; i < s_array.size(); i++) {
+      const Opt3001Slot &slot = s_array.slot(i);
+      board.sensor(slot.mux, slot.channel, slot.col).setOscillator(osc[i] *= 1.0002);
+    }
+    run(s_array, 100);
+  }
+
+  for (uint8_t i = 0; i < s_array.size(); i++) {
+    const Opt3001Slot &slot = s_array.slot(i);
+    SimOpt3001 &dev = board.sensor(slot.mux, slot.channel, slot.col);
+    uint32_t conversions = dev.conversions() - convs[i];
+    uint32_t read        = dev.resultReads() - reads[i];
+    TEST_ASSERT_UINT32_WITHIN(1, conversions, read);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(dev.conversions(), dev.resultReads());
+    TEST_ASSERT_EQUAL(0, slot.status);
+    configs += dev.configReads();
+    results += read;
+  }
+  char line[96];
+  snprintf(line, sizeof(line), "%u Results, %u Config-Abfragen", (unsigned)results, (unsigned)configs);
+  TEST_MESSAGE(line);
+  TEST_ASSERT_LESS_THAN_UINT32(results, configs);
+}
+
+// Streaming: der Pointer bleibt auf Result, ein Read im
+// Raster ist nur requestFrom(). Gesetzt wird der Pointer nur
+// für eine CRF-Abfrage und danach zurück auf Result, auf
+// dem Wire- wie dem gebündelten Pfad.
+void test_grid_reads_skip_pointer_write(void) {
+  for (uint8_t batched = 0; batched < 2; batched++) {
+    sim::reset();
+    SimBoard board;
+    board.setLux(321.0);
+    boot(s_array);
+    s_array.setBatched(batched);
+    run(s_array, 3000);   // Raster verankern
+
+    uint32_t results = 0, configs = 0, pointers = 0;
+    for (uint8_t i = 0; i < s_array.size(); i++) {
+      const Opt3001Slot &slot = s_array.slot(i);
+      SimOpt3001 &dev = board.sensor(slot.mux, slot.channel, slot.col);
+      results  -= dev.resultReads();
+      configs  -= dev.configReads();
+      pointers -= dev.pointerWrites();
+    }
+    run(s_array, 2000);
+    for (uint8_t i = 0; i < s_array.size(); i++) {
+      const Opt3001Slot &slot = s_array.slot(i);
+      SimOpt3001 &dev = board.sensor(slot.mux, slot.channel, slot.col);
+      results  += dev.resultReads();
+      configs  += dev.configReads();
+      pointers += dev.pointerWrites();
+    }
+    char line[96];
+    snprintf(line, sizeof(line), "%s: %u Results, %u Config, %u Pointer", batched ? "gebündelt" : "Wire",
+             (unsigned)results, (unsigned)configs, (unsigned)pointers);
+    TEST_MESSAGE(line);
+
+    // hin und zurück je Abfrage; die meisten Results ohne Pointer
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(2 * configs, pointers);
+    TEST_ASSERT_LESS_THAN_UINT32(results / 2, pointers);
+    Wire.end();
+  }
+}
+
+// ----------------------------------------------------
+// Gebündelt vs. Wire
+// ----------------------------------------------------
+// Gleiche Bytes auf dem Bus, aber ein Treiberaufruf je
+// Kanal und Schritt (Mux, Result bzw. Config, Result)
+// statt je Registerzugriff. Jede Transaktion weniger spart 50 µs
+// Overhead und den Takt ihres STOP.
+void test_batched_pass_saves_driver_calls(void) {
+  SimBus::Stats stats[2];
+  for (uint8_t batched = 0; batched < 2; batched++) {
+    sim::reset();
+    SimBoard board;
+    boot(s_array);
+    s_array.setBatched(batched);
+    sim::bus(0).setOverheadUs(50);
+    delay(100);   // alle Wandlungen fertig
+    sim::bus(0).resetStats();
+    s_array.service(micros());
+    stats[batched] = sim::bus(0).stats();
+
+    for (uint8_t i = 0; i < s_array.size(); i++) TEST_ASSERT_EQUAL(0, s_array.slot(i).status);
+    Wire.end();
+  }
+
+  // Wire: mindestens ein Zugriff je Sensor (im Raster nur das Result);
+  // gebündelt: höchstens drei je Kanal
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT32(TOTAL_SENSORS, stats[0].transactions);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(3 * TOTAL_ROWS, stats[1].transactions);
+  TEST_ASSERT_EQUAL_UINT32(stats[0].bytes, stats[1].bytes);
+  TEST_ASSERT_EQUAL_UINT64(stats[0].busyNs - stats[1].busyNs,
+                           (uint64_t)(stats[0].transactions - stats[1].transactions) *
+                           (50000 + 1000000000ULL / I2C_FREQ_HZ));
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_register_read_time_100k);
+  RUN_TEST(test_register_read_time_400k);
+  RUN_TEST(test_register_read_time_1m);
+  RUN_TEST(test_mux_rejects_1m);
+  RUN_TEST(test_scan_time_scales_with_clock);
+  RUN_TEST(test_discovery_maps_every_sensor);
+  RUN_TEST(test_broadcast_collides_by_design);
+  RUN_TEST(test_colliding_read_is_wired_and);
+  RUN_TEST(test_missing_sensor_nacks_then_hotplugs);
+  RUN_TEST(test_failed_sensor_backs_off);
+  RUN_TEST(test_settle_calibration_finds_slow_channel);
+  RUN_TEST(test_crf_follows_conversion_time);
+  RUN_TEST(test_singleshot_stops_after_one_conversion);
+  RUN_TEST(test_every_conversion_read_once);
+  RUN_TEST(test_grid_reads_result_only_under_drift);
+  RUN_TEST(test_grid_reads_skip_pointer_write);
+  RUN_TEST(test_batched_pass_saves_driver_calls);
+  return UNITY_END();
+}
@@ -0,0 +1,62 @@
+"""
+Dashboard gzip-komprimiert als C-Array einbetten.
+
+web/index.html -> include/dashboard_html_gz.h
+
+Läuft als PlatformIO-Pre-Script (extra_scripts) vor jedem Build
+oder direkt:  python tools/embed_dashboard.py
+Die Ausgabe ist deterministisch (gzip ohne Zeitstempel/Dateiname),
+der Header wird nur neu geschrieben, wenn sich der Inhalt ändert.
+Das ETag ist ein Hash der komprimierten Bytes.
+"""
+import gzip
+import hashlib
+import os
+
+try:
+    Import("env")  # noqa: F821  (nur unter PlatformIO definiert)
+    ROOT = env.subst("$PROJECT_DIR")  # noqa: F821
+except NameError:
+    ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+SOURCE = os.path.join(ROOT, "web", "index.html")
+TARGET = os.path.join(ROOT, "include", "dashboard_html_gz.h")
+
+
+def render(data):
+    packed = gzip.compress(data, compresslevel=9, mtime=0)
+    etag = hashlib.sha256(packed).hexdigest()[:16]
+
+    lines = [
+        "// Automatisch erzeugt von tools/embed_dashboard.py aus web/index.html",
+        "// - nicht von Hand ändern",
+        "#ifndef DASHBOARD_HTML_GZ_H",
+        "#define DASHBOARD_HTML_GZ_H",
+        "",
+        "#include <Arduino.h>",
+        "",
+        '#define DASHBOARD_HTML_GZ_ETAG "\\"%s\\""' % etag,
+        "#define DASHBOARD_HTML_SIZE    %d   // unkomprimiert" % len(data),
+        "",
+        "static const uint8_t DASHBOARD_HTML_GZ[%d] PROGMEM = {" % len(packed),
+    ]
+    for i in range(0, len(packed), 16):
+        lines.append("  " + ", ".join("0x%02x" % b for b in packed[i:i + 16]) + ",")
+    lines += ["};", "", "#endif", ""]
+    return "\n".join(lines)
+
+
+def main():
+    with open(SOURCE, "rb") as f:
+        header = render(f.read())
+
+    if os.path.exists(TARGET):
+        with open(TARGET, "r", encoding="utf-8") as f:
+            if f.read() == header:
+                return
+    with open(TARGET, "w", encoding="utf-8", newline="\n") as f:
+        f.write(header)
+    print("embed_dashboard: %s aktualisiert" % os.path.relpath(TARGET, ROOT))
+
+
+main()